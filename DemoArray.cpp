@@ -5,6 +5,7 @@ using namespace std;
 #include "containers/array.h"
 #include "compareFunc.h"
 #include "variadic-util.h"
+#include "pipeline.h"
 
 using T1 = int;
 
@@ -62,6 +63,12 @@ void DemoArray() {
 
     cout << "Terminó #2" << endl; 
 
+    // Mismo efecto que Foreach(&Suma) + Foreach(&Mult) pero en una sola pasada
+    auto total = Pipe(arr1) | Map([](T1 x){ return (x + 4) * 3; })
+                            | Filter([](T1 x){ return x % 2 == 0; })
+                            | Reduce([](T1 a, T1 b){ return a + b; }, 0);
+    cout << "Suma de pares ((x+4)*3): " << total << endl;
+
     auto iter = arr1.FirstThat( &Mult7 ); 
     if( iter != arr1.end() )
     {   cout << "El primer multiplo de 7 es: " << *iter << endl; }
@@ -0,0 +1,259 @@
+// ============================================================
+//  bench_binarytree.cpp  –  CBinaryTree con Insert/Remove/Find iterativos
+//  Claves al azar: N Insert, N Find (aciertos) y N Remove.
+//  Claves ordenadas: el arbol degenera en una cadena de profundidad n;
+//  Insert es O(n^2) pero ya no desborda la pila (antes: recursion por
+//  nivel). Por eso la cantidad ordenada es un argumento aparte.
+//  std::multiset (balanceado) como referencia.
+//  Busquedas ordenadas sobre N claves al azar: Find contra FirstThat
+//  (recorrido completo) y ForeachInRange contra Foreach filtrando;
+//  LowerBound/UpperBound/EqualRange se validan contra std::multiset.
+//  Asignador de nodos (Traits): new/delete contra CNodePool en Insert,
+//  recorrido in-orden, Remove + reinsercion (free list) y destruccion.
+//  Snapshot: BuildFromSorted (ordenado y desordenado) y recarga con
+//  operator>> del formato de operator<< (ordenado: una pasada lineal).
+//  g++ -std=c++17 -O2 -pthread bench_binarytree.cpp -o bench_binarytree
+//  ./bench_binarytree [N al azar] [N ordenado] [N snapshot]
+// ============================================================
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <set>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include "containers/binarytree.h"
+
+using Clock = std::chrono::steady_clock;
+using Tree     = CBinaryTree< TreeTraitAscending<int> >;
+using PoolTree = CBinaryTree< TreeTraitAscendingPool<int> >;
+
+static double Ms(Clock::time_point start){
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void BenchRandom(const std::vector<int> &keys){
+    std::vector<int> order(keys);
+    std::shuffle(order.begin(), order.end(), std::mt19937(3));
+    size_t found = 0;
+    {
+        Tree tree;
+        auto t0 = Clock::now();
+        for(size_t i = 0; i < keys.size(); ++i)
+            tree.Insert(keys[i], ref_type(i));
+        double tInsert = Ms(t0);
+        t0 = Clock::now();
+        for(int key : order)
+            found += tree.Find(key) != nullptr;
+        double tFind = Ms(t0);
+        t0 = Clock::now();
+        for(int key : order)
+            tree.Remove(key);
+        double tRemove = Ms(t0);
+        bool empty = !(tree.begin() != tree.end());
+        std::cout << std::left << std::setw(22) << "CBinaryTree" << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << tInsert << std::setw(10) << tFind << std::setw(10) << tRemove
+                  << (found == keys.size() && empty ? "" : "  [ERROR]") << "\n";
+    }
+    std::multiset<int> set;
+    auto t0 = Clock::now();
+    for(int key : keys)
+        set.insert(key);
+    double tInsert = Ms(t0);
+    found = 0;
+    t0 = Clock::now();
+    for(int key : order)
+        found += set.find(key) != set.end();
+    double tFind = Ms(t0);
+    t0 = Clock::now();
+    for(int key : order)
+        set.erase(set.find(key));
+    double tRemove = Ms(t0);
+    std::cout << std::left << std::setw(22) << "std::multiset" << std::right
+              << std::setw(10) << tInsert << std::setw(10) << tFind << std::setw(10) << tRemove
+              << (found == keys.size() && set.empty() ? "" : "  [ERROR]") << "\n";
+}
+
+void BenchLookups(const std::vector<int> &keys, size_t queries){
+    Tree tree;
+    std::multiset<int> set(keys.begin(), keys.end());
+    for(size_t i = 0; i < keys.size(); ++i)
+        tree.Insert(keys[i], ref_type(i));
+    std::mt19937 gen(5);
+    std::vector<int> probes(queries);
+    for(auto &probe : probes)
+        probe = keys[gen() % keys.size()];
+    bool ok = true;
+
+    size_t hits = 0;
+    auto t0 = Clock::now();
+    for(int probe : probes)
+        hits += tree.Find(probe) != nullptr && tree.Contains(probe);
+    double tFind = Ms(t0);
+    t0 = Clock::now();
+    for(int probe : probes)
+        hits -= tree.FirstThat([](int &val, int key){ return val == key; }, probe) != nullptr;
+    double tScan = Ms(t0);
+    ok &= hits == 0;
+
+    // Rangos de ~100 claves (la densidad es N / 2^31)
+    int width = int(100.0 * 2147483648.0 / keys.size());
+    long long sumRange = 0, sumScan = 0;
+    t0 = Clock::now();
+    for(int probe : probes)
+        tree.ForeachInRange(probe, probe + width, [&sumRange](int &val){ sumRange += val; });
+    double tRange = Ms(t0);
+    t0 = Clock::now();
+    for(int probe : probes)
+        tree.Foreach([&sumScan](int &val, int lo, int hi){ if( lo <= val && val <= hi ) sumScan += val; },
+                     probe, probe + width);
+    double tFilter = Ms(t0);
+    ok &= sumRange == sumScan;
+
+    for(size_t q = 0; q < queries && ok; ++q){
+        int probe = probes[q] + int(q % 3) - 1;     // presentes y ausentes
+        auto lower = tree.LowerBound(probe);
+        auto upper = tree.UpperBound(probe);
+        auto range = tree.EqualRange(probe);
+        auto sLower = set.lower_bound(probe), sUpper = set.upper_bound(probe);
+        ok &= (lower != tree.end()) == (sLower != set.end()) && (lower == tree.end() || *lower == *sLower);
+        ok &= (upper != tree.end()) == (sUpper != set.end()) && (upper == tree.end() || *upper == *sUpper);
+        ok &= range.first == lower && range.second == upper;
+    }
+    std::cout << queries << " busquedas: Find " << tFind << " ms, FirstThat " << tScan << " ms; rangos de ~100: "
+              << "ForeachInRange " << tRange << " ms, Foreach filtrando " << tFilter << " ms"
+              << (ok ? "" : "  [ERROR]") << "\n";
+}
+
+// N Insert, 3 recorridos in-orden, N/2 Remove + N/2 Insert, destruir
+template <typename T>
+void BenchAllocator(const char *name, const std::vector<int> &keys){
+    long long sum = 0;
+    double tInsert, tForeach, tChurn, tDestroy;
+    {
+        T tree;
+        auto t0 = Clock::now();
+        for(size_t i = 0; i < keys.size(); ++i)
+            tree.Insert(keys[i], ref_type(i));
+        tInsert = Ms(t0);
+        t0 = Clock::now();
+        for(int pass = 0; pass < 3; ++pass)
+            tree.Foreach([&sum](int &val){ sum += val; });
+        tForeach = Ms(t0);
+        t0 = Clock::now();
+        for(size_t i = 0; i < keys.size(); i += 2)
+            tree.Remove(keys[i]);
+        for(size_t i = 0; i < keys.size(); i += 2)
+            tree.Insert(keys[i], ref_type(i));
+        tChurn = Ms(t0);
+        t0 = Clock::now();
+        T dying(std::move(tree));           // el pool viaja con los nodos
+        tree.Foreach([&sum](int &val){ sum += val; });  // vacio
+        dying.Clear();
+        tDestroy = Ms(t0);
+    }
+    std::cout << std::left << std::setw(22) << name << std::right
+              << std::setw(10) << tInsert << std::setw(10) << tForeach << std::setw(10) << tChurn
+              << std::setw(10) << tDestroy << "   (checksum " << sum << ")\n";
+}
+
+// Cadena: cada Insert recorre todo lo anterior
+void BenchSorted(size_t N){
+    Tree tree;
+    auto t0 = Clock::now();
+    for(size_t i = 0; i < N; ++i)
+        tree.Insert(int(i), ref_type(i));
+    double tInsert = Ms(t0);
+    t0 = Clock::now();
+    bool ok = tree.Find(int(N - 1)) != nullptr && tree.Find(int(N)) == nullptr;
+    double tFind = Ms(t0);
+    t0 = Clock::now();
+    tree.Remove(0);                         // la raiz: un solo hijo
+    tree.Remove(int(N / 2));
+    double tRemove = Ms(t0);
+    t0 = Clock::now();
+    {
+        Tree dying(std::move(tree));        // destructor sobre la cadena
+    }
+    double tDestroy = Ms(t0);
+    std::cout << "Ordenado N = " << N << ": Insert " << tInsert << " ms (profundidad " << N
+              << "), 2 Find " << tFind << " ms, 2 Remove " << tRemove << " ms, destruir "
+              << tDestroy << " ms" << (ok ? "" : "  [ERROR]") << "\n";
+}
+
+// Cuenta nodos y verifica el orden con el ForwardIterator (usa m_pParent)
+static bool CheckInorder(PoolTree &tree, size_t expected){
+    size_t n = 0;
+    int    last = 0;
+    bool   sorted = true;
+    for(auto it = tree.begin(); it != tree.end(); ++it, ++n){
+        sorted &= n == 0 || last <= *it;
+        last = *it;
+    }
+    return sorted && n == expected;
+}
+
+void BenchSnapshot(size_t N){
+    std::vector<int> sorted(N);
+    for(size_t i = 0; i < N; ++i)
+        sorted[i] = int(2 * i);
+    PoolTree tree;
+    auto t0 = Clock::now();
+    tree.BuildFromSorted(sorted.begin(), sorted.end());
+    double tBuild = Ms(t0);
+    bool ok = CheckInorder(tree, N) && tree.Contains(int(N)) && !tree.Contains(1);
+
+    std::vector<int> shuffled(sorted);
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(11));
+    t0 = Clock::now();
+    tree.BuildFromSorted(shuffled.begin(), shuffled.end());
+    double tUnsorted = Ms(t0);
+    ok &= CheckInorder(tree, N);
+    std::vector<int>().swap(shuffled);
+
+    t0 = Clock::now();
+    std::string snapshot;
+    {
+        std::ostringstream os;
+        os << tree;
+        snapshot = os.str();
+    }
+    double tWrite = Ms(t0);
+    tree.Clear();
+    t0 = Clock::now();
+    {
+        std::istringstream is(snapshot);
+        is >> tree;
+    }
+    double tReload = Ms(t0);
+    ok &= CheckInorder(tree, N);
+    std::cout << "Snapshot N = " << N << ": BuildFromSorted " << tBuild << " ms, desordenado (ordena) "
+              << tUnsorted << " ms; operator<< " << tWrite << " ms, operator>> " << tReload << " ms ("
+              << snapshot.size() / (1 << 20) << " MiB)" << (ok ? "" : "  [ERROR]") << "\n";
+}
+
+int main(int argc, char *argv[]){
+    size_t N       = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t NSorted = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+    size_t NSnap   = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 10000000;
+    std::mt19937 gen(42);
+    std::vector<int> keys(N);
+    for(auto &key : keys)
+        key = int(gen() >> 1);
+
+    std::cout << "Al azar N = " << N << " (ms)\n";
+    std::cout << std::left << std::setw(22) << "" << std::right << std::setw(10) << "Insert"
+              << std::setw(10) << "Find" << std::setw(10) << "Remove" << "\n";
+    BenchRandom(keys);
+    BenchLookups(keys, 100);
+    std::cout << "Asignador de nodos (ms)\n" << std::left << std::setw(22) << "" << std::right
+              << std::setw(10) << "Insert" << std::setw(10) << "3 Foreach" << std::setw(10) << "Rem+Ins"
+              << std::setw(10) << "destruir" << "\n";
+    BenchAllocator<Tree>    ("new/delete", keys);
+    BenchAllocator<PoolTree>("CNodePool",  keys);
+    BenchSorted(NSorted);
+    BenchSnapshot(NSnap);
+    return 0;
+}
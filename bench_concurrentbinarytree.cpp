@@ -0,0 +1,115 @@
+// ============================================================
+//  bench_concurrentbinarytree.cpp  –  CConcurrentBinaryTree (lock coupling)
+//  Solo escritores: cada hilo hace 50% Insert y 50% Remove de claves al
+//  azar en [0, keyRange), de 1 a 16 hilos, contra CBinaryTree con su
+//  unico lock (CRecursiveLock). El arbol se precarga con la mitad de las
+//  claves en orden aleatorio (profundidad ~ log n).
+//  Valida: orden in-orden, getSize == recorrido == precarga + netos.
+//  g++ -std=c++17 -O2 -pthread bench_concurrentbinarytree.cpp -o bench_concurrentbinarytree
+//  ./bench_concurrentbinarytree [keyRange] [ms por corrida]
+// ============================================================
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include "containers/concurrentbinarytree.h"
+#include "containers/binarytree.h"
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Tree>
+bool RemoveOne(Tree &tree, int key){ return tree.Remove(key); }
+// CBinaryTree::Remove no informa si borro: no cuenta para los netos
+template <typename Traits>
+bool RemoveOne(CBinaryTree<Traits> &tree, int key){ tree.Remove(key); return false; }
+
+template <typename Tree>
+void Preload(Tree &tree, int keyRange){
+    std::vector<int> keys;
+    for(int k = 0; k < keyRange; k += 2)
+        keys.push_back(k);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+    for(int key : keys)
+        tree.Insert(key, key);
+}
+
+template <typename Tree>
+double Run(Tree &tree, int nThreads, int keyRange, int ms, long long &net){
+    std::atomic<bool>      stop{false};
+    std::atomic<long long> totalOps{0}, totalNet{0};
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nThreads; ++t)
+        threads.emplace_back([&, t](){
+            std::mt19937 gen(1234 + t);
+            long long ops = 0, myNet = 0;
+            while( !stop.load(std::memory_order_relaxed) ){
+                for(int i = 0; i < 64; ++i, ++ops){
+                    unsigned r   = gen();
+                    int      key = int(r % unsigned(keyRange));
+                    if( r >> 31 ){
+                        tree.Insert(key, key);
+                        ++myNet;
+                    }
+                    else
+                        myNet -= RemoveOne(tree, key);
+                }
+            }
+            totalOps += ops;
+            totalNet += myNet;
+        });
+    auto t0 = Clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    stop = true;
+    for(auto &th : threads)
+        th.join();
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+    net += totalNet;
+    return totalOps / secs / 1e6;
+}
+
+// Cantidad de nodos; false si el in-orden no queda ordenado
+template <typename Tree>
+bool Validate(Tree &tree, size_t &counted){
+    bool sorted = true;
+    int  last   = -1;
+    counted = 0;
+    tree.Foreach([&](int &value){ sorted &= value >= last; last = value; ++counted; });
+    return sorted;
+}
+
+int main(int argc, char *argv[]){
+    int keyRange = argc > 1 ? std::atoi(argv[1]) : 1 << 20;
+    int ms       = argc > 2 ? std::atoi(argv[2]) : 300;
+    std::cout << "keyRange = " << keyRange << ", " << ms << " ms por corrida, hw = "
+              << std::thread::hardware_concurrency() << " hilos\n";
+    std::cout << std::setw(8) << "threads" << std::setw(20) << "lock coupling Mops"
+              << std::setw(20) << "un lock Mops" << "\n";
+
+    for(int nThreads : {1, 2, 4, 8, 16}){
+        CConcurrentBinaryTree< TreeTraitAscending<int> > tree;
+        CBinaryTree< TreeTraitAscending<int> >           reference;
+        Preload(tree, keyRange);
+        Preload(reference, keyRange);
+        long long netTree = (keyRange + 1) / 2, netRef = 0;
+        double lc = Run(tree,      nThreads, keyRange, ms, netTree);
+        double gl = Run(reference, nThreads, keyRange, ms, netRef);
+
+        size_t counted;
+        assert(Validate(tree, counted)          && "el in-orden debe quedar ordenado");
+        assert(counted == tree.getSize()        && "getSize debe coincidir con el recorrido");
+        assert((long long)counted == netTree    && "precarga + inserts - removes exitosos == elementos");
+        assert(Validate(reference, counted)     && "CBinaryTree: el in-orden debe quedar ordenado");
+        (void)counted;
+
+        std::cout << std::setw(8) << nThreads << std::fixed << std::setprecision(2)
+                  << std::setw(20) << lc << std::setw(20) << gl << "\n";
+    }
+    std::cout << "OK: escritores concurrentes sin perdidas ni duplicados\n";
+    return 0;
+}
@@ -0,0 +1,129 @@
+// ============================================================
+//  bench_concurrentlist.cpp  –  CConcurrentLinkedList (lock-free)
+//  Prueba de estres + throughput de 1 a 16 hilos, comparado con
+//  una lista ordenada (std::forward_list) protegida por un solo std::mutex.
+//  g++ -std=c++17 -O2 -pthread bench_concurrentlist.cpp -o bench_concurrentlist
+//  ./bench_concurrentlist [keyRange] [ms por corrida]
+// ============================================================
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <forward_list>
+#include <mutex>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include "containers/concurrentlist.h"
+
+using Clock = std::chrono::steady_clock;
+static long long g_sink = 0;     // evita que el compilador descarte los Contains
+
+// Misma complejidad (lista ordenada), pero con un unico mutex
+struct MutexList{
+    std::mutex             m_mtx;
+    std::forward_list<int> m_list;
+
+    // Ultimo nodo con valor < val (o before_begin)
+    std::forward_list<int>::iterator Prev(int val){
+        auto prev = m_list.before_begin();
+        for(auto iter = m_list.begin(); iter != m_list.end() && *iter < val; ++iter)
+            prev = iter;
+        return prev;
+    }
+    bool Insert(int val, ref_type){
+        std::lock_guard<std::mutex> lock(m_mtx);
+        auto prev = Prev(val), next = std::next(prev);
+        if( next != m_list.end() && *next == val )
+            return false;
+        m_list.insert_after(prev, val);
+        return true;
+    }
+    bool Remove(int val){
+        std::lock_guard<std::mutex> lock(m_mtx);
+        auto prev = Prev(val), next = std::next(prev);
+        if( next == m_list.end() || *next != val )
+            return false;
+        m_list.erase_after(prev);
+        return true;
+    }
+    bool Contains(int val){
+        std::lock_guard<std::mutex> lock(m_mtx);
+        auto next = std::next(Prev(val));
+        return next != m_list.end() && *next == val;
+    }
+};
+
+// 80% Contains, 10% Insert, 10% Remove sobre claves en [0, keyRange)
+template <typename Set>
+double Run(Set &set, int nThreads, int keyRange, int ms, long long &net){
+    std::atomic<bool>      stop{false};
+    std::atomic<long long> totalOps{0}, totalNet{0}, totalHits{0};
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nThreads; ++t)
+        threads.emplace_back([&, t](){
+            std::mt19937 gen(1234 + t);
+            long long ops = 0, myNet = 0, hits = 0;
+            while( !stop.load(std::memory_order_relaxed) ){
+                for(int i = 0; i < 64; ++i, ++ops){
+                    unsigned r   = gen();
+                    int      key = r % keyRange;
+                    unsigned op  = (r >> 20) % 10;
+                    if( op == 0 )      myNet += set.Insert(key, key);
+                    else if( op == 1 ) myNet -= set.Remove(key);
+                    else               hits  += set.Contains(key);   // usar el resultado
+                }
+            }
+            totalOps += ops;
+            totalNet += myNet;
+            totalHits += hits;
+        });
+    auto t0 = Clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    stop = true;
+    for(auto &th : threads)
+        th.join();
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+    net += totalNet;
+    g_sink += totalHits;
+    return totalOps / secs / 1e6;
+}
+
+int main(int argc, char *argv[]){
+    int keyRange = argc > 1 ? std::atoi(argv[1]) : 512;
+    int ms       = argc > 2 ? std::atoi(argv[2]) : 300;
+    std::cout << "keyRange = " << keyRange << ", " << ms << " ms por corrida, hw = "
+              << std::thread::hardware_concurrency() << " hilos\n";
+    std::cout << std::setw(8) << "threads" << std::setw(16) << "lock-free Mops"
+              << std::setw(16) << "mutex Mops" << "\n";
+
+    for(int nThreads : {1, 2, 4, 8, 16}){
+        CConcurrentLinkedList< AscendingTrait<int> > list;
+        MutexList reference;
+        long long netList = 0, netRef = 0;
+        // Precarga a la mitad
+        for(int k = 0; k < keyRange; k += 2){
+            netList += list.Insert(k, k);
+            netRef  += reference.Insert(k, k);
+        }
+        double lf = Run(list,      nThreads, keyRange, ms, netList);
+        double mx = Run(reference, nThreads, keyRange, ms, netRef);
+
+        // Validacion: tamano consistente y orden estricto
+        size_t counted = 0;
+        int    last    = -1;
+        bool   sorted  = true;
+        list.Foreach([&](const int &value){ sorted &= value > last; last = value; ++counted; });
+        assert(sorted                           && "la lista debe quedar estrictamente ordenada");
+        assert(counted == list.getSize()        && "getSize debe coincidir con el recorrido");
+        assert((long long)counted == netList    && "inserts - removes exitosos == elementos");
+        (void)netRef;
+
+        std::cout << std::setw(8) << nThreads << std::fixed << std::setprecision(2)
+                  << std::setw(16) << lf << std::setw(16) << mx << "\n";
+    }
+    std::cout << "OK: estres sin perdidas ni duplicados (hits " << g_sink << ")\n";
+    return 0;
+}
@@ -0,0 +1,293 @@
+// ============================================================
+//  bench_heap.cpp  –  CHeap d-ario: D = 2 vs D = 4 (vs std::priority_queue)
+//  Heaps grandes (mas que la cache): Push de N, Pop de N y N PushPop en
+//  estado estable; ademas Heapify de un CArray.
+//  Dijkstra sobre un grafo aleatorio (N/10 nodos, grado 8): CIndexedHeap
+//  con DecreaseKey contra heaps "perezosos" que insertan duplicados.
+//  Meld: N/10 elementos repartidos en 4096 shards que se fusionan de a
+//  pares; CPairingHeap (Meld O(1)) contra CHeap (se vuelca el menor).
+//  Regresion: CIndexedHeap con std::string debe salir en orden.
+//  g++ -std=c++17 -O2 -pthread bench_heap.cpp -o bench_heap
+//  ./bench_heap [N]
+// ============================================================
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <string>
+#include <cstdlib>
+#include "containers/heap.h"
+#include "containers/array.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double Ms(Clock::time_point start){
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Adaptador para medir std::priority_queue con la misma interfaz y la
+// misma carga por elemento (valor + ref)
+struct StdHeap{
+    using Elem = std::pair<int, ref_type>;
+    std::priority_queue<Elem, std::vector<Elem>, std::greater<Elem> > m_pq;
+    void Push(int val, ref_type ref){ m_pq.emplace(val, ref); }
+    int  Pop()                      { int top = m_pq.top().first; m_pq.pop(); return top; }
+    int  PushPop(int val, ref_type ref){
+        m_pq.emplace(val, ref);
+        return Pop();
+    }
+};
+
+template <typename Heap>
+void Bench(const char *name, const std::vector<int> &values){
+    size_t N = values.size();
+    long long checksum = 0;
+    Heap heap;
+
+    auto t0 = Clock::now();
+    for(size_t i = 0; i < N; ++i)
+        heap.Push(values[i], i);
+    double tPush = Ms(t0);
+
+    t0 = Clock::now();
+    for(size_t i = 0; i < N; ++i)
+        checksum += heap.PushPop(values[N - 1 - i] ^ 0x5555, i);
+    double tPushPop = Ms(t0);
+
+    t0 = Clock::now();
+    int  last    = -1;
+    bool ordered = true;
+    for(size_t i = 0; i < N; ++i){
+        int top = heap.Pop();
+        ordered &= top >= last;
+        last = top;
+        checksum += top;
+    }
+    double tPop = Ms(t0);
+
+    std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << tPush << std::setw(12) << tPushPop << std::setw(12) << tPop
+              << "   (checksum " << checksum << (ordered ? ")" : ") [ERROR]") << "\n";
+}
+
+template <size_t D>
+double HeapifyArray(CArray< Trait1<int> > &arr){
+    CHeap< TreeTraitAscending<int>, D > heap;
+    auto t0 = Clock::now();
+    heap.Heapify(arr);
+    double t = Ms(t0);
+    if( heap.getSize() != size_t(arr.getSize()) )
+        std::cout << "[ERROR] Heapify\n";
+    return t;
+}
+
+// Grafo en formato CSR: aristas de v en [m_start[v], m_start[v+1])
+struct Graph{
+    std::vector<size_t> m_start;
+    std::vector<int>    m_to, m_weight;
+};
+
+static Graph RandomGraph(size_t V, size_t degree, std::mt19937 &gen){
+    Graph g;
+    g.m_start.resize(V + 1);
+    for(size_t v = 0; v < V; ++v){
+        g.m_start[v] = g.m_to.size();
+        for(size_t k = 0; k < degree; ++k){
+            g.m_to.push_back(int(gen() % V));
+            g.m_weight.push_back(int(1 + gen() % 1000));
+        }
+    }
+    g.m_start[V] = g.m_to.size();
+    return g;
+}
+
+const long long Infinity = (1LL << 62);
+
+template <size_t D>
+double DijkstraIndexed(const Graph &g, std::vector<long long> &dist, size_t &relaxations){
+    size_t V = g.m_start.size() - 1;
+    dist.assign(V, Infinity);
+    auto t0 = Clock::now();
+    CIndexedHeap< TreeTraitAscending<long long>, D > heap(V);
+    dist[0] = 0;
+    heap.Push(0, 0);
+    while( !heap.empty() ){
+        ref_type u;
+        long long d = heap.Pop(u);
+        for(size_t e = g.m_start[u]; e < g.m_start[u + 1]; ++e){
+            int       v  = g.m_to[e];
+            long long nd = d + g.m_weight[e];
+            if( nd < dist[v] ){
+                ++relaxations;
+                if( heap.Contains(v) )
+                    heap.DecreaseKey(v, nd);
+                else
+                    heap.Push(nd, v);
+                dist[v] = nd;
+            }
+        }
+    }
+    return Ms(t0);
+}
+
+// Sin decrease-key: se inserta otra copia y las viejas se descartan al salir
+template <typename Heap>
+double DijkstraLazy(const Graph &g, std::vector<long long> &dist){
+    size_t V = g.m_start.size() - 1;
+    dist.assign(V, Infinity);
+    auto t0 = Clock::now();
+    Heap heap;
+    dist[0] = 0;
+    heap.Push(0, 0);
+    while( !heap.empty() ){
+        ref_type  u;
+        long long d = heap.Pop(u);
+        if( d > dist[u] )
+            continue;
+        for(size_t e = g.m_start[u]; e < g.m_start[u + 1]; ++e){
+            int       v  = g.m_to[e];
+            long long nd = d + g.m_weight[e];
+            if( nd < dist[v] ){
+                dist[v] = nd;
+                heap.Push(nd, v);
+            }
+        }
+    }
+    return Ms(t0);
+}
+
+struct StdLazyHeap{
+    using Elem = std::pair<long long, ref_type>;
+    std::priority_queue<Elem, std::vector<Elem>, std::greater<Elem> > m_pq;
+    void      Push(long long val, ref_type ref){ m_pq.emplace(val, ref); }
+    bool      empty() const                    { return m_pq.empty();    }
+    long long Pop(ref_type &ref){
+        Elem top = m_pq.top();
+        m_pq.pop();
+        ref = top.second;
+        return top.first;
+    }
+};
+
+// Fusion del mas chico dentro del mas grande (lo mejor que admite un heap en arreglo)
+template <typename Heap>
+void MeldInto(Heap &a, Heap &b){
+    if( a.getSize() < b.getSize() )
+        std::swap(a, b);
+    b.Foreach([&a](int value){ a.Push(value); });
+    b.Clear();
+}
+template <typename Traits, template <typename> class Alloc>
+void MeldInto(CPairingHeap<Traits, Alloc> &a, CPairingHeap<Traits, Alloc> &b){
+    a.Meld(std::move(b));
+}
+
+// Las shards se fusionan de a pares (consultando el Top de cada resultado);
+// despues se sacan los 1000 mejores y por ultimo se vacia el heap
+template <typename Heap>
+void BenchMeld(const char *name, const std::vector<int> &values, size_t nShards){
+    std::vector<Heap> shards(nShards);
+    for(size_t i = 0; i < values.size(); ++i)
+        shards[i % nShards].Push(values[i], i);
+    long long checksum = 0;
+    auto t0 = Clock::now();
+    for(size_t step = 1; step < nShards; step *= 2)
+        for(size_t i = 0; i + step < nShards; i += 2 * step){
+            MeldInto(shards[i], shards[i + step]);
+            checksum += shards[i].Top();
+        }
+    double tMeld = Ms(t0);
+    t0 = Clock::now();
+    int  last    = -1;
+    bool ordered = true;
+    for(int k = 0; k < 1000 && !shards[0].empty(); ++k){
+        int top = shards[0].Pop();
+        ordered &= top >= last;
+        last = top;
+        checksum += top;
+    }
+    double tTopK = Ms(t0);
+    t0 = Clock::now();
+    while( !shards[0].empty() ){
+        int top = shards[0].Pop();
+        ordered &= top >= last;
+        last = top;
+        checksum += top;
+    }
+    double tPop = Ms(t0);
+    std::cout << "  " << std::left << std::setw(16) << name << std::right << " melds " << tMeld
+              << " ms, top-1000 " << tTopK << " ms, vaciar " << tPop << " ms (checksum " << checksum
+              << (ordered ? ")" : ") [ERROR]") << "\n";
+}
+
+// Regresion: Pop mueve el valor del tope antes de RemoveAt(0); con un
+// value_type no trivial (string vacio tras el move) no debe elegir SiftUp
+static bool IndexedHeapStrings(){
+    CIndexedHeap< TreeTraitDescending<std::string> > heap;
+    const char *letters[] = {"b", "a", "d", "c", "e", "f", "g", "h"};
+    for(ref_type ref = 0; ref < 8; ++ref)
+        heap.Push(letters[ref], ref);
+    std::string drained;
+    while( !heap.empty() )
+        drained += heap.Pop();
+    return drained == "hgfedcba";
+}
+
+// Regresion: refs nunca insertadas o ya sacadas no se indexan en m_pos
+static bool IndexedHeapMissingRefs(){
+    CIndexedHeap< TreeTraitAscending<int> > heap(4);
+    heap.Push(10, 0);
+    heap.Push(20, 1);
+    heap.Pop();                                     // saca la ref 0
+    bool ok = true;
+    for(ref_type ref : {ref_type(0), ref_type(3), ref_type(1000)})
+        ok &= !heap.DecreaseKey(ref, 1) && !heap.IncreaseKey(ref, 99) && !heap.Update(ref, 5);
+    return ok && heap.Update(1, 5) && heap.Top() == 5 && heap.getSize() == 1;
+}
+
+int main(int argc, char *argv[]){
+    size_t N = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    std::mt19937 gen(42);
+    std::vector<int> values(N);
+    for(auto &v : values)
+        v = int(gen() >> 1);
+
+    std::cout << "N = " << N << " (tiempos en ms)\n";
+    std::cout << std::left << std::setw(20) << "heap" << std::right
+              << std::setw(12) << "Push" << std::setw(12) << "PushPop" << std::setw(12) << "Pop" << "\n";
+    Bench< CHeap< TreeTraitAscending<int>, 2 > >("CHeap D=2", values);
+    Bench< CHeap< TreeTraitAscending<int>, 4 > >("CHeap D=4", values);
+    Bench< CHeap< TreeTraitAscending<int>, 8 > >("CHeap D=8", values);
+    Bench< StdHeap >                            ("priority_queue", values);
+
+    CArray< Trait1<int> > arr(N);
+    for(size_t i = 0; i < N; ++i)
+        arr.push_back(values[i], i);
+    std::cout << "Heapify(CArray): D=2 " << HeapifyArray<2>(arr) << " ms, D=4 "
+              << HeapifyArray<4>(arr) << " ms\n";
+
+    size_t V = N / 10;
+    Graph  g = RandomGraph(V, 8, gen);
+    std::vector<long long> d4, d2, dLazy, dStd;
+    size_t relax = 0, relax2 = 0;
+    double t4    = DijkstraIndexed<4>(g, d4, relax);
+    double t2    = DijkstraIndexed<2>(g, d2, relax2);
+    double tLazy = DijkstraLazy< CHeap< TreeTraitAscending<long long>, 4 > >(g, dLazy);
+    double tStd  = DijkstraLazy< StdLazyHeap >(g, dStd);
+    bool   same  = d4 == d2 && d4 == dLazy && d4 == dStd;
+    std::cout << "Dijkstra V = " << V << ", E = " << g.m_to.size() << ", relajaciones = " << relax << "\n"
+              << "  CIndexedHeap D=4 " << t4 << " ms, D=2 " << t2 << " ms; perezoso CHeap D=4 "
+              << tLazy << " ms, priority_queue " << tStd << " ms" << (same ? "" : "  [ERROR]") << "\n";
+
+    std::cout << "CIndexedHeap<std::string>: Pop en orden" << (IndexedHeapStrings() ? "" : "  [ERROR]") << "\n";
+    std::cout << "CIndexedHeap: refs ausentes" << (IndexedHeapMissingRefs() ? "" : "  [ERROR]") << "\n";
+
+    std::vector<int> meldValues(values.begin(), values.begin() + N / 10);
+    std::cout << "Meld de " << meldValues.size() << " elementos en 4096 shards\n";
+    BenchMeld< CPairingHeap< TreeTraitAscending<int> > >("CPairingHeap", meldValues, 4096);
+    BenchMeld< CHeap< TreeTraitAscending<int>, 4 > >   ("CHeap D=4",    meldValues, 4096);
+    return 0;
+}
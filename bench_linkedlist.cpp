@@ -0,0 +1,165 @@
+// ============================================================
+//  bench_linkedlist.cpp  –  CLinkedList: new/delete vs CNodePool,
+//                           CUnrolledLinkedList y CArray como referencia
+//  g++ -std=c++17 -O2 -pthread bench_linkedlist.cpp -o bench_linkedlist
+//  ./bench_linkedlist [N]
+// ============================================================
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include "containers/linkedlist.h"
+#include "containers/unrolledlist.h"
+#include "containers/array.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double Ms(Clock::time_point start){
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Otras asignaciones intercaladas para que el heap se fragmente como en produccion
+static std::vector<std::vector<char> *> g_noise;
+
+template <typename List>
+void Bench(const char *name, const std::vector<int> &values, size_t nOrdered){
+    long long checksum = 0;
+
+    auto t0 = Clock::now();
+    auto *pList = new List;
+    for(size_t i = 0; i < values.size(); ++i){
+        pList->push_back(values[i], i);
+        if( i % 4 == 0 )
+            g_noise.push_back(new std::vector<char>(24));
+    }
+    double tPush = Ms(t0);
+
+    t0 = Clock::now();
+    for(int rep = 0; rep < 10; ++rep)
+        for(auto iter = pList->begin(); iter != pList->end(); ++iter)
+            checksum += *iter;
+    double tTraverse = Ms(t0) / 10;
+
+    t0 = Clock::now();
+    delete pList;
+    double tDestroy = Ms(t0);
+
+    // Insert ordenado: O(n) por elemento, se mide con menos elementos
+    t0 = Clock::now();
+    List ordered;
+    for(size_t i = 0; i < nOrdered; ++i)
+        ordered.Insert(values[i], i);
+    double tOrdered = Ms(t0);
+
+    t0 = Clock::now();
+    for(auto iter = ordered.begin(); iter != ordered.end(); ++iter)
+        checksum += *iter;
+    double tOrderedTraverse = Ms(t0);
+
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << tPush
+              << std::setw(12) << tTraverse
+              << std::setw(12) << tDestroy
+              << std::setw(14) << tOrdered
+              << std::setw(14) << tOrderedTraverse
+              << "   (checksum " << checksum << ")\n";
+}
+
+int main(int argc, char *argv[]){
+    size_t N        = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    size_t nOrdered = N < 20000 ? N : 20000;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 1 << 30);
+    std::vector<int> values(N);
+    for(auto &v : values)
+        v = dist(gen);
+
+    std::cout << "N = " << N << ", ordered Insert N = " << nOrdered << " (tiempos en ms)\n";
+    std::cout << std::left << std::setw(10) << "alloc" << std::right
+              << std::setw(12) << "push_back"
+              << std::setw(12) << "traverse"
+              << std::setw(12) << "destroy"
+              << std::setw(14) << "Insert(ord)"
+              << std::setw(14) << "trav(ord)" << "\n";
+    Bench< CLinkedList< AscendingTrait<int> > >            ("new",      values, nOrdered);
+    Bench< CLinkedList< AscendingPoolTrait<int> > >        ("pool",     values, nOrdered);
+    Bench< CUnrolledLinkedList< AscendingUnrolledTrait<int> > >("unrolled", values, nOrdered);
+
+    // Persistencia binaria: escribir y recargar N elementos ordenados
+    {
+        CLinkedList< AscendingPoolTrait<int> > sorted, reloaded;
+        std::vector<int> ordered(values);
+        std::sort(ordered.begin(), ordered.end());
+        for(size_t i = 0; i < N; ++i)
+            sorted.push_back(ordered[i], i);
+        std::stringstream ss;
+        auto t0 = Clock::now();
+        sorted.Write(ss);
+        double tWrite = Ms(t0);
+        t0 = Clock::now();
+        bool ok = reloaded.Read(ss);
+        double tRead = Ms(t0);
+        ok &= reloaded.getSize() == N;
+        // Truncado: Read falla y no deja una carga parcial
+        std::string bytes = ss.str();
+        std::stringstream truncated(bytes.substr(0, bytes.size() / 2));
+        ok &= !reloaded.Read(truncated) && reloaded.getSize() == 0;
+        std::cout << "Write " << N << ": " << tWrite << " ms, Read: " << tRead << " ms"
+                  << (ok ? "" : "  [ERROR]") << "\n";
+    }
+
+    // Lote de nOrdered elementos sobre una lista de N: Insert uno a uno vs InsertBatch / Merge
+    {
+        std::vector<int> ordered(values);
+        std::sort(ordered.begin(), ordered.end());
+        std::vector<int> batch(values.begin(), values.begin() + nOrdered);
+        CLinkedList< AscendingPoolTrait<int> > one, many, merged, other;
+        for(size_t i = 0; i < N; ++i){
+            one.push_back(ordered[i], i);
+            many.push_back(ordered[i], i);
+            merged.push_back(ordered[i], i);
+        }
+        size_t nSingle = nOrdered < 200 ? nOrdered : 200;    // O(n) cada uno
+        auto t0 = Clock::now();
+        for(size_t i = 0; i < nSingle; ++i)
+            one.Insert(batch[i], i);
+        double tSingle = Ms(t0) * nOrdered / nSingle;
+        t0 = Clock::now();
+        many.InsertBatch(batch);
+        double tBatch = Ms(t0);
+        other.InsertBatch(batch);
+        t0 = Clock::now();
+        merged.Merge(std::move(other));
+        double tMerge = Ms(t0);
+        std::cout << "lote " << nOrdered << " sobre " << N << ": Insert x" << nOrdered << " ~" << tSingle
+                  << " ms (extrapolado), InsertBatch: " << tBatch << " ms, Merge: " << tMerge << " ms"
+                  << (many.getSize() == merged.getSize() ? "" : "  [ERROR]") << "\n";
+    }
+
+    // Referencia: recorrido de un CArray con los mismos datos
+    CArray< Trait1<int> > arr(N);
+    for(size_t i = 0; i < N; ++i)
+        arr.push_back(values[i], i);
+    long long checksum = 0;
+    auto t0 = Clock::now();
+    for(int rep = 0; rep < 10; ++rep)
+        for(auto iter = arr.begin(); iter != arr.end(); ++iter)
+            checksum += *iter;
+    std::cout << std::left << std::setw(10) << "CArray" << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << "-" << std::setw(12) << Ms(t0) / 10
+              << "   (checksum " << checksum << ")\n";
+
+    std::cout << "bytes/elem: nodo simple = " << sizeof(NodeLinkedList< AscendingPoolTrait<int> >)
+              << ", nodo desenrollado = " << sizeof(NodeUnrolledList< AscendingUnrolledTrait<int> >)
+              << " / " << NodeUnrolledList< AscendingUnrolledTrait<int> >::Capacity << " elementos\n";
+
+    for(auto pNoise : g_noise)
+        delete pNoise;
+    return 0;
+}
@@ -0,0 +1,136 @@
+// ============================================================
+//  bench_lrucache.cpp  –  CLRUCache / CShardedLRUCache
+//  1) Latencia del camino de acierto (Get) frente al LRU clasico
+//     std::list + std::unordered_map.
+//  2) Throughput multihilo (90% Get, 10% Put) de CShardedLRUCache con
+//     16 shards contra 1 sola shard (un unico mutex).
+//  g++ -std=c++17 -O2 -pthread bench_lrucache.cpp -o bench_lrucache
+//  ./bench_lrucache [capacidad] [ms por corrida]
+// ============================================================
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstdlib>
+#include "containers/lrucache.h"
+
+using Clock = std::chrono::steady_clock;
+static long long g_sink = 0;     // evita que el compilador descarte los Get
+
+// LRU de referencia: nodo de lista + nodo de hash por entrada
+struct StdLRU{
+    size_t m_capacity;
+    std::list< std::pair<ref_type, ref_type> > m_list;
+    std::unordered_map<ref_type, decltype(m_list)::iterator> m_index;
+
+    explicit StdLRU(size_t capacity) : m_capacity(capacity){ m_index.reserve(2 * capacity); }
+    bool Get(ref_type key, ref_type &value){
+        auto iter = m_index.find(key);
+        if( iter == m_index.end() )
+            return false;
+        m_list.splice(m_list.begin(), m_list, iter->second);
+        value = iter->second->second;
+        return true;
+    }
+    void Put(ref_type key, ref_type value){
+        auto iter = m_index.find(key);
+        if( iter != m_index.end() ){
+            iter->second->second = value;
+            m_list.splice(m_list.begin(), m_list, iter->second);
+            return;
+        }
+        m_list.emplace_front(key, value);
+        m_index[key] = m_list.begin();
+        if( m_list.size() > m_capacity ){
+            m_index.erase(m_list.back().first);
+            m_list.pop_back();
+        }
+    }
+};
+
+template <typename Cache>
+double HitLatency(Cache &cache, size_t capacity, const std::vector<ref_type> &keys){
+    for(size_t k = 0; k < capacity; ++k)
+        cache.Put(k, k);
+    ref_type value = 0;
+    auto t0 = Clock::now();
+    for(auto key : keys){
+        cache.Get(key, value);
+        g_sink += value;
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / keys.size();
+}
+
+// Claves en [0, 2*capacidad): en estado estable ~50% de aciertos
+template <size_t Shards>
+double Throughput(size_t capacity, int nThreads, int ms, double &hitRatio){
+    CShardedLRUCache<ref_type, ref_type, Shards> cache(capacity);
+    std::atomic<bool>      stop{false};
+    std::atomic<long long> totalOps{0};
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nThreads; ++t)
+        threads.emplace_back([&, t](){
+            std::mt19937 gen(77 + t);
+            long long ops = 0, sink = 0;
+            ref_type  value;
+            while( !stop.load(std::memory_order_relaxed) ){
+                for(int i = 0; i < 64; ++i, ++ops){
+                    unsigned r   = gen();
+                    ref_type key = r % (2 * capacity);
+                    if( (r >> 28) % 10 == 0 || !cache.Get(key, value) )
+                        cache.Put(key, key);
+                    else
+                        sink += value;
+                }
+            }
+            totalOps += ops;
+            g_sink   += sink;
+        });
+    auto t0 = Clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    stop = true;
+    for(auto &th : threads)
+        th.join();
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+    hitRatio = cache.HitRatio();
+    return totalOps / secs / 1e6;
+}
+
+int main(int argc, char *argv[]){
+    size_t capacity = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    int    ms       = argc > 2 ? std::atoi(argv[2]) : 300;
+
+    std::mt19937 gen(42);
+    std::vector<ref_type> keys(4000000);
+    for(auto &key : keys)
+        key = gen() % capacity;
+
+    {
+        CLRUCache<> lru(capacity);
+        StdLRU      reference(capacity);
+        double tLru = HitLatency(lru,       capacity, keys);
+        double tStd = HitLatency(reference, capacity, keys);
+        std::cout << "capacidad = " << capacity << ", Get con acierto (ns/op): CLRUCache "
+                  << std::fixed << std::setprecision(1) << tLru << ", list+unordered_map " << tStd
+                  << "  (hits " << lru.getHits() << ")\n";
+    }
+
+    std::cout << ms << " ms por corrida, hw = " << std::thread::hardware_concurrency() << " hilos\n";
+    std::cout << std::setw(8) << "threads" << std::setw(18) << "16 shards Mops"
+              << std::setw(16) << "1 shard Mops" << std::setw(10) << "hit %" << "\n";
+    for(int nThreads : {1, 2, 4, 8, 16}){
+        double hits16, hits1;
+        double sharded = Throughput<16>(capacity, nThreads, ms, hits16);
+        double single  = Throughput<1> (capacity, nThreads, ms, hits1);
+        std::cout << std::setw(8) << nThreads << std::fixed << std::setprecision(2)
+                  << std::setw(18) << sharded << std::setw(16) << single
+                  << std::setw(10) << 100 * hits16 << "\n";
+    }
+    std::cout << "(checksum " << g_sink << ")\n";
+    return 0;
+}
@@ -0,0 +1,181 @@
+// ============================================================
+//  bench_multiqueue.cpp  –  CMultiQueue (cola de prioridad relajada)
+//  1) Throughput de 1 a 16 hilos contra un CHeap con un solo mutex.
+//     Cada hilo hace TryPop y vuelve a insertar (clave + delta), como un
+//     planificador o un Dijkstra: el tamano se mantiene constante.
+//  2) Calidad: rank error de cada Pop (cuantos elementos mejores habia en
+//     la cola), reproduciendo el log de operaciones con un arbol de Fenwick.
+//  g++ -std=c++17 -O2 -pthread bench_multiqueue.cpp -o bench_multiqueue
+//  ./bench_multiqueue [prefill] [ms por corrida]
+// ============================================================
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include "containers/multiqueue.h"
+
+using Clock = std::chrono::steady_clock;
+using Key   = long long;
+using Trait = TreeTraitAscending<Key>;          // min-heap
+
+// Referencia: un unico heap protegido por un mutex
+struct LockedHeap{
+    std::mutex   m_mtx;
+    CHeap<Trait> m_heap;
+    void Push(Key val, ref_type ref = -1){
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_heap.Push(val, ref);
+    }
+    bool TryPop(Key &val){
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if( m_heap.empty() )
+            return false;
+        val = m_heap.Pop();
+        return true;
+    }
+};
+
+template <typename PQ>
+double Throughput(PQ &pq, size_t prefill, int nThreads, int ms){
+    std::mt19937_64 gen(7);
+    for(size_t i = 0; i < prefill; ++i)
+        pq.Push(Key(gen() % (prefill * 10)));
+    std::atomic<bool>      stop{false};
+    std::atomic<long long> totalOps{0};
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nThreads; ++t)
+        threads.emplace_back([&, t](){
+            std::mt19937 local(100 + t);
+            long long ops = 0;
+            Key       val;
+            while( !stop.load(std::memory_order_relaxed) )
+                for(int i = 0; i < 32; ++i, ops += 2)
+                    if( pq.TryPop(val) )
+                        pq.Push(val + 1 + local() % 1000);
+            totalOps += ops;
+        });
+    auto t0 = Clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    stop = true;
+    for(auto &th : threads)
+        th.join();
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+    return totalOps / secs / 1e6;
+}
+
+// ----- Calidad (rank error) -----
+struct LogEntry{
+    long long m_seq;
+    Key       m_value;
+    bool      m_push;
+};
+
+struct Fenwick{
+    std::vector<long long> m_tree;
+    explicit Fenwick(size_t n) : m_tree(n + 1, 0){}
+    void Add(size_t i, long long delta){
+        for(++i; i < m_tree.size(); i += i & (~i + 1))
+            m_tree[i] += delta;
+    }
+    long long Prefix(size_t i) const{              // suma de [0, i)
+        long long sum = 0;
+        for(; i > 0; i -= i & (~i + 1))
+            sum += m_tree[i];
+        return sum;
+    }
+};
+
+// Cada Pop + Push (y su entrada en el log) se hace bajo logMtx para que el
+// orden del log sea exacto: se mide el error que introduce la relajacion
+// (eleccion al azar entre c*p heaps), no el de las carreras entre hilos.
+void RankError(size_t prefill, int nThreads, size_t c, size_t opsPerThread){
+    CMultiQueue<Trait> pq(nThreads, c);
+    std::atomic<long long> seq{0};
+    std::mutex             logMtx;
+    std::vector<LogEntry> prefillLog;
+    std::mt19937_64 gen(7);
+    for(size_t i = 0; i < prefill; ++i){
+        Key val = Key(gen() % (prefill * 10));
+        prefillLog.push_back({seq++, val, true});
+        pq.Push(val);
+    }
+    std::vector< std::vector<LogEntry> > logs(nThreads);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nThreads; ++t)
+        threads.emplace_back([&, t](){
+            std::mt19937 local(100 + t);
+            auto &log = logs[t];
+            log.reserve(2 * opsPerThread);
+            Key val;
+            for(size_t i = 0; i < opsPerThread; ++i){
+                std::lock_guard<std::mutex> lock(logMtx);
+                if( !pq.TryPop(val) )
+                    continue;
+                log.push_back({seq++, val, false});
+                Key next = val + 1 + local() % 1000;
+                log.push_back({seq++, next, true});
+                pq.Push(next);
+            }
+        });
+    for(auto &th : threads)
+        th.join();
+
+    std::vector<LogEntry> all(prefillLog);
+    for(auto &log : logs)
+        all.insert(all.end(), log.begin(), log.end());
+    std::sort(all.begin(), all.end(), [](const LogEntry &a, const LogEntry &b){ return a.m_seq < b.m_seq; });
+    std::vector<Key> keys;
+    for(auto &entry : all)
+        keys.push_back(entry.m_value);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    Fenwick   present(keys.size());
+    long long sumRank = 0, maxRank = 0, pops = 0;
+    for(auto &entry : all){
+        size_t idx = std::lower_bound(keys.begin(), keys.end(), entry.m_value) - keys.begin();
+        if( entry.m_push )
+            present.Add(idx, 1);
+        else{
+            long long rank = present.Prefix(idx);     // estrictamente mejores
+            sumRank += rank;
+            maxRank  = std::max(maxRank, rank);
+            ++pops;
+            present.Add(idx, -1);
+        }
+    }
+    std::cout << std::setw(8) << nThreads << std::setw(4) << c << std::setw(10) << pq.getQueues()
+              << std::fixed << std::setprecision(2) << std::setw(14) << double(sumRank) / pops
+              << std::setw(12) << maxRank << "\n";
+}
+
+int main(int argc, char *argv[]){
+    size_t prefill = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    int    ms      = argc > 2 ? std::atoi(argv[2]) : 300;
+    std::cout << "prefill = " << prefill << ", " << ms << " ms por corrida, hw = "
+              << std::thread::hardware_concurrency() << " hilos\n";
+    std::cout << std::setw(8) << "threads" << std::setw(20) << "MultiQueue c=2 Mops"
+              << std::setw(18) << "1 heap+mutex Mops" << "\n";
+    for(int nThreads : {1, 2, 4, 8, 16}){
+        CMultiQueue<Trait> multi(nThreads, 2);
+        LockedHeap         single;
+        double mq = Throughput(multi,  prefill, nThreads, ms);
+        double sh = Throughput(single, prefill, nThreads, ms);
+        std::cout << std::setw(8) << nThreads << std::fixed << std::setprecision(2)
+                  << std::setw(20) << mq << std::setw(18) << sh << "\n";
+    }
+
+    std::cout << "\nrank error (0 = cola estricta)\n";
+    std::cout << std::setw(8) << "threads" << std::setw(4) << "c" << std::setw(10) << "heaps"
+              << std::setw(14) << "promedio" << std::setw(12) << "maximo" << "\n";
+    for(int nThreads : {1, 4, 16})
+        for(size_t c : {1, 2, 4})
+            RankError(prefill / 10, nThreads, c, 200000 / nThreads);
+    return 0;
+}
@@ -0,0 +1,199 @@
+// ============================================================
+//  bench_queue.cpp  –  CQueue
+//  SPSC: throughput productor -> consumidor (de a uno y por lotes
+//        PushN/PopN) y latencia de ida y vuelta (ping-pong con 2 colas).
+//  MPMC: de 1 a 32 hilos, cada uno alterna Push/Pop bloqueantes, contra
+//        una cola std::deque protegida por un std::mutex.
+//  Deque: CChunkedDeque contra std::deque (llenar/vaciar y FIFO estable).
+//  g++ -std=c++17 -O2 -pthread bench_queue.cpp -o bench_queue
+//  ./bench_queue [N]
+// ============================================================
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include "containers/queue.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double Secs(Clock::time_point start){
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Con menos nucleos que hilos, ceder la CPU en vez de girar en vano
+static void Backoff(){ std::this_thread::yield(); }
+
+// Devuelve Mops; valida que llegan todos y en orden
+double SPSCThroughput(size_t N, size_t batch){
+    CQueue< SPSCQueueTrait<long> > queue(4096);
+    auto t0 = Clock::now();
+    std::thread producer([&](){
+        std::vector<long> values(batch);
+        for(size_t i = 0; i < N; ){
+            if( batch == 1 ){
+                while( !queue.TryPush(long(i)) )
+                    Backoff();
+                ++i;
+                continue;
+            }
+            size_t n = N - i < batch ? N - i : batch;
+            for(size_t k = 0; k < n; ++k)
+                values[k] = long(i + k);
+            size_t done = 0;
+            while( done < n ){
+                size_t pushed = queue.PushN(values.data() + done, n - done);
+                if( !pushed )
+                    Backoff();
+                done += pushed;
+            }
+            i += n;
+        }
+    });
+    std::vector<long> values(batch);
+    long expected = 0;
+    bool ordered  = true;
+    while( size_t(expected) < N ){
+        size_t n = batch == 1 ? queue.TryPop(values[0]) : queue.PopN(values.data(), batch);
+        if( !n )
+            Backoff();
+        for(size_t k = 0; k < n; ++k)
+            ordered &= values[k] == expected++;
+    }
+    producer.join();
+    double secs = Secs(t0);
+    assert(ordered && queue.empty() && "SPSC: perdida o desorden");
+    return N / secs / 1e6;
+}
+
+// Latencia de ida y vuelta (ns) con dos colas SPSC
+double SPSCPingPong(size_t rounds){
+    CQueue< SPSCQueueTrait<long> > ping(64), pong(64);
+    std::thread echo([&](){
+        long val;
+        for(size_t i = 0; i < rounds; ++i){
+            while( !ping.TryPop(val) )
+                Backoff();
+            while( !pong.TryPush(val) )
+                Backoff();
+        }
+    });
+    auto t0 = Clock::now();
+    long val;
+    for(size_t i = 0; i < rounds; ++i){
+        while( !ping.TryPush(long(i)) )
+            Backoff();
+        while( !pong.TryPop(val) )
+            Backoff();
+        assert(val == long(i));
+    }
+    double ns = Secs(t0) * 1e9 / rounds;
+    echo.join();
+    return ns;
+}
+
+// Referencia MPMC: std::deque + un mutex + condition_variable
+struct MutexQueue{
+    std::mutex              m_mtx;
+    std::condition_variable m_notEmpty;
+    std::deque<long>        m_deque;
+
+    void Push(long val){
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            m_deque.push_back(val);
+        }
+        m_notEmpty.notify_one();
+    }
+    void Pop(long &val){
+        std::unique_lock<std::mutex> lock(m_mtx);
+        m_notEmpty.wait(lock, [this](){ return !m_deque.empty(); });
+        val = m_deque.front();
+        m_deque.pop_front();
+    }
+};
+
+// Cada hilo hace opsPerThread pares Push/Pop; valida que la suma sacada
+// sea igual a la puesta (nada se pierde ni se duplica)
+template <typename Queue>
+double PairsThroughput(Queue &queue, int nThreads, size_t opsPerThread){
+    std::atomic<long long> pushed{0}, popped{0};
+    std::vector<std::thread> threads;
+    auto t0 = Clock::now();
+    for(int t = 0; t < nThreads; ++t)
+        threads.emplace_back([&, t](){
+            long long in = 0, out = 0;
+            long      val;
+            for(size_t i = 0; i < opsPerThread; ++i){
+                long v = long(t) * long(opsPerThread) + long(i);
+                queue.Push(v);
+                in += v;
+                queue.Pop(val);
+                out += val;
+            }
+            pushed += in;
+            popped += out;
+        });
+    for(auto &th : threads)
+        th.join();
+    double secs = Secs(t0);
+    assert(pushed == popped && "MPMC: perdida o duplicado");
+    return 2.0 * nThreads * opsPerThread / secs / 1e6;
+}
+
+// Llena N, recorre por indice y vacia; luego FIFO estable (push + pop)
+template <typename Deque>
+double DequeRun(Deque &deque, size_t N, long long &checksum){
+    auto t0 = Clock::now();
+    for(size_t i = 0; i < N; ++i)
+        deque.push_back(long(i));
+    for(size_t i = 0; i < N; i += 7)
+        checksum += deque[i];
+    for(size_t i = 0; i < N; ++i)
+        deque.pop_front();
+    for(size_t i = 0; i < 1024; ++i)
+        deque.push_back(long(i));
+    for(size_t i = 0; i < N; ++i){
+        checksum += deque.front();
+        deque.pop_front();
+        deque.push_back(long(i));
+    }
+    return Secs(t0) * 1e3;
+}
+
+int main(int argc, char *argv[]){
+    size_t N = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50000000;
+    std::cout << "N = " << N << ", hw = " << std::thread::hardware_concurrency() << " hilos\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "SPSC TryPush/TryPop:   " << SPSCThroughput(N, 1)   << " Mops\n";
+    std::cout << "SPSC PushN/PopN (64):  " << SPSCThroughput(N, 64)  << " Mops\n";
+    std::cout << "SPSC PushN/PopN (256): " << SPSCThroughput(N, 256) << " Mops\n";
+    std::cout << "SPSC ping-pong:        " << SPSCPingPong(N / 500)  << " ns ida y vuelta\n";
+
+    size_t total = N / 10;
+    std::cout << std::setw(8) << "threads" << std::setw(14) << "MPMC Mops" << std::setw(18) << "mutex+deque Mops" << "\n";
+    for(int nThreads : {1, 2, 4, 8, 16, 32}){
+        CQueue< MPMCQueueTrait<long> > mpmc(1024);
+        MutexQueue reference;
+        double lf = PairsThroughput(mpmc,      nThreads, total / nThreads);
+        double mx = PairsThroughput(reference, nThreads, total / nThreads);
+        std::cout << std::setw(8) << nThreads << std::setw(14) << lf << std::setw(18) << mx << "\n";
+    }
+
+    {
+        long long c1 = 0, c2 = 0;
+        CQueue< DequeQueueTrait<long> > chunked;
+        std::deque<long>                reference;
+        double tChunked = DequeRun(chunked,   N / 5, c1);
+        double tStd     = DequeRun(reference, N / 5, c2);
+        std::cout << "Deque " << N / 5 << ": CChunkedDeque " << tChunked << " ms, std::deque "
+                  << tStd << " ms" << (c1 == c2 ? "" : "  [ERROR]") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+// ============================================================
+//  bench_stack.cpp  –  CStack
+//  1 hilo: CSegmentedStack contra std::stack (deque y vector) y una pila
+//          con mutex: N push + N pop, y rafagas push/pop en el borde de
+//          un segmento (debe no pedir memoria).
+//  Multi-hilo: pool LIFO estilo work-stealing, de 1 a 16 hilos: cada
+//          hilo empuja una rafaga de 8 tareas y saca 8 (propias o
+//          ajenas). CTreiberStack contra std::stack + std::mutex.
+//  En Xeon tipo Skylake el lazo de pop puede quedar cruzando un limite de
+//  32 bytes (erratum JCC) y medir 5x peor segun como caiga el binario;
+//  para descartarlo: -Wa,-mbranches-within-32B-boundaries
+//  g++ -std=c++17 -O2 -pthread bench_stack.cpp -o bench_stack
+//  ./bench_stack [N]
+// ============================================================
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <stack>
+#include <mutex>
+#include <atomic>
+#include <cstdlib>
+#include "containers/stack.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double Ms(Clock::time_point start){
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Adaptadores con la interfaz push/pop/top/empty de std::stack
+template <typename Stack>
+struct MutexStack{
+    std::mutex m_mtx;
+    Stack      m_stack;
+    void push(long val){
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_stack.push(val);
+    }
+    void pop(){
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_stack.pop();
+    }
+    long &top()        { return m_stack.top();   }
+    bool  empty() const{ return m_stack.empty(); }
+    bool  TryPush(long val){ push(val); return true; }
+    bool  TryPop(long &val){
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if( m_stack.empty() )
+            return false;
+        val = m_stack.top();
+        m_stack.pop();
+        return true;
+    }
+};
+
+// N push + N pop, y despues rafagas de 64 alrededor del borde de un segmento
+template <typename Stack>
+void BenchSingle(const char *name, size_t N){
+    Stack stack;
+    long long checksum = 0;
+    auto t0 = Clock::now();
+    for(size_t i = 0; i < N; ++i)
+        stack.push(long(i));
+    double tPush = Ms(t0);
+    t0 = Clock::now();
+    bool ordered = true;
+    for(size_t i = N; i-- > 0; ){
+        ordered &= stack.top() == long(i);
+        checksum += stack.top();
+        stack.pop();
+    }
+    double tPop = Ms(t0);
+
+    size_t edge = CSegmentedStack<long>::SegmentSize - 32;
+    for(size_t i = 0; i < edge; ++i)
+        stack.push(long(i));
+    t0 = Clock::now();
+    for(size_t round = 0; round < N / 64; ++round){
+        for(long k = 0; k < 64; ++k)
+            stack.push(k);
+        for(long k = 0; k < 64; ++k){
+            checksum += stack.top();
+            stack.pop();
+        }
+    }
+    double tBurst = Ms(t0);
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << tPush << std::setw(10) << tPop << std::setw(12) << tBurst
+              << "   (checksum " << checksum << (ordered ? ")" : ") [ERROR]") << "\n";
+}
+
+// Cada hilo: rafagas de 8 push y 8 TryPop; valida que la suma sacada
+// sea la puesta (nada se pierde ni se duplica)
+template <typename Stack>
+double PoolThroughput(Stack &stack, int nThreads, size_t opsPerThread){
+    std::atomic<long long> pushed{0}, popped{0};
+    std::vector<std::thread> threads;
+    auto t0 = Clock::now();
+    for(int t = 0; t < nThreads; ++t)
+        threads.emplace_back([&, t](){
+            long long in = 0, out = 0;
+            long      val;
+            for(size_t i = 0; i < opsPerThread; i += 8){
+                for(size_t k = 0; k < 8; ++k){
+                    long v = long(t) * long(opsPerThread) + long(i + k);
+                    stack.TryPush(v);
+                    in += v;
+                }
+                for(size_t k = 0; k < 8; ++k)
+                    if( stack.TryPop(val) )
+                        out += val;
+            }
+            pushed += in;
+            popped += out;
+        });
+    for(auto &th : threads)
+        th.join();
+    double ms = Ms(t0);
+    long val;
+    long long rest = 0;
+    while( stack.TryPop(val) )
+        rest += val;
+    if( pushed != popped + rest )
+        std::cout << "[ERROR] pool: perdida o duplicado\n";
+    return 2.0 * nThreads * opsPerThread / ms / 1e3;
+}
+
+int main(int argc, char *argv[]){
+    size_t N = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000000;
+    std::cout << "N = " << N << ", hw = " << std::thread::hardware_concurrency() << " hilos (tiempos en ms)\n";
+    std::cout << std::left << std::setw(24) << "pila" << std::right << std::setw(10) << "push"
+              << std::setw(10) << "pop" << std::setw(12) << "rafagas" << "\n";
+    BenchSingle< CStack< SegmentedStackTrait<long> > >          ("CStack segmentada", N);
+    BenchSingle< std::stack<long> >                             ("std::stack (deque)", N);
+    BenchSingle< std::stack<long, std::vector<long> > >         ("std::stack (vector)", N);
+    BenchSingle< MutexStack< std::stack<long> > >               ("std::stack + mutex", N);
+
+    size_t total = N / 2;
+    std::cout << std::setw(8) << "threads" << std::setw(16) << "Treiber Mops" << std::setw(16) << "mutex Mops" << "\n";
+    for(int nThreads : {1, 2, 4, 8, 16}){
+        CStack< TreiberStackTrait<long> > treiber;
+        MutexStack< std::stack<long> >    reference;
+        double lf = PoolThroughput(treiber,   nThreads, total / nThreads);
+        double mx = PoolThroughput(reference, nThreads, total / nThreads);
+        std::cout << std::setw(8) << nThreads << std::setw(16) << lf << std::setw(16) << mx << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+// ============================================================
+//  bench_streaming.cpp  –  operadores de flujo sobre CHeap
+//  El flujo se genera al vuelo (xorshift), nunca se guarda completo.
+//  1) Top-K (CTopK) contra juntar todo en un arreglo y ordenarlo.
+//  2) Mediana de todo el flujo (CRunningMedian) contra juntar y ordenar.
+//  3) Mediana de ventana deslizante (CSlidingMedian) contra dos
+//     std::multiset con borrado exacto (sobre N/10, mismo resultado).
+//  Ademas cuenta las llamadas a operator new despues del calentamiento.
+//  g++ -std=c++17 -O2 -pthread bench_streaming.cpp -o bench_streaming
+//  ./bench_streaming [N] [K] [W]
+// ============================================================
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "containers/streamstats.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Cuenta cada pedido de memoria del proceso
+static std::atomic<size_t> g_allocs{0};
+void *operator new(size_t size){
+    ++g_allocs;
+    if( void *p = std::malloc(size ? size : 1) )
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept            { std::free(p); }
+void operator delete(void *p, size_t) noexcept    { std::free(p); }
+
+static double Secs(Clock::time_point start){
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Stream{
+    uint64_t m_state;
+    explicit Stream(uint64_t seed) : m_state(seed){}
+    int Next(){
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 7;
+        m_state ^= m_state << 17;
+        return int(m_state >> 33);
+    }
+};
+
+using Elem = std::pair<int, ref_type>;
+
+void BenchTopK(size_t N, size_t K){
+    CTopK< TreeTraitAscending<int> > topk(K);
+    Stream stream(1);
+    size_t warm = std::min(N, K), allocs = g_allocs;
+    auto t0 = Clock::now();
+    for(size_t i = 0; i < N; ++i){
+        if( i == warm )
+            allocs = g_allocs;
+        topk.Push(stream.Next(), ref_type(i));
+    }
+    double tHeap = Secs(t0);
+    allocs = g_allocs - allocs;
+    std::vector<CTopK< TreeTraitAscending<int> >::Node> best;
+    topk.GetSorted(best);
+
+    stream = Stream(1);
+    t0 = Clock::now();
+    std::vector<Elem> all;
+    for(size_t i = 0; i < N; ++i)
+        all.emplace_back(stream.Next(), ref_type(i));
+    std::sort(all.begin(), all.end(), std::greater<Elem>());
+    double tSort = Secs(t0);
+    bool same = best.size() == std::min(N, K);
+    for(size_t i = 0; same && i < best.size(); ++i)
+        same = best[i].m_value == all[i].first;
+
+    std::cout << "Top-" << K << ": CTopK " << N / tHeap / 1e6 << " Mops (" << allocs
+              << " new tras calentar), juntar+ordenar " << N / tSort / 1e6 << " Mops"
+              << (same ? "" : "  [ERROR]") << "\n";
+}
+
+void BenchRunningMedian(size_t N){
+    CRunningMedian<int> median(N);
+    Stream stream(2);
+    double checksum = 0;
+    size_t allocs = g_allocs;
+    auto t0 = Clock::now();
+    for(size_t i = 0; i < N; ++i){
+        median.Push(stream.Next(), ref_type(i));
+        if( (i & 1023) == 0 )
+            checksum += median.Median();
+    }
+    double tHeap = Secs(t0);
+    allocs = g_allocs - allocs;
+    double result = median.Median();
+    median.Clear();
+
+    stream = Stream(2);
+    t0 = Clock::now();
+    std::vector<int> all;
+    for(size_t i = 0; i < N; ++i)
+        all.push_back(stream.Next());
+    std::sort(all.begin(), all.end());
+    double expected = N % 2 ? all[N / 2] : (double(all[N / 2 - 1]) + all[N / 2]) / 2;
+    double tSort = Secs(t0);
+
+    std::cout << "Mediana: CRunningMedian " << N / tHeap / 1e6 << " Mops (" << allocs
+              << " new con reserve), juntar+ordenar (una sola vez) " << N / tSort / 1e6 << " Mops"
+              << (result == expected ? "" : "  [ERROR]") << "  (checksum " << checksum << ")\n";
+}
+
+// Referencia: dos multiset (mitad menor / mitad mayor) con borrado exacto
+struct MultisetMedian{
+    std::multiset<int> m_low, m_high;
+    std::vector<int>   m_ring;
+    size_t             m_next = 0;
+    explicit MultisetMedian(size_t window) : m_ring(window){}
+    double Push(int val){
+        size_t W = m_ring.size();
+        if( m_next >= W ){
+            int old = m_ring[m_next % W];
+            if( old <= *m_low.rbegin() )
+                m_low.erase(m_low.find(old));
+            else
+                m_high.erase(m_high.find(old));
+        }
+        m_ring[m_next++ % W] = val;
+        if( m_low.empty() || val <= *m_low.rbegin() )
+            m_low.insert(val);
+        else
+            m_high.insert(val);
+        while( m_low.size() > m_high.size() + 1 ){
+            m_high.insert(*m_low.rbegin());
+            m_low.erase(std::prev(m_low.end()));
+        }
+        while( m_high.size() > m_low.size() ){
+            m_low.insert(*m_high.begin());
+            m_high.erase(m_high.begin());
+        }
+        if( m_low.size() > m_high.size() )
+            return *m_low.rbegin();
+        return (double(*m_low.rbegin()) + *m_high.begin()) / 2;
+    }
+};
+
+void BenchSlidingMedian(size_t N, size_t W){
+    size_t M = N / 10;
+    CSlidingMedian<int> sliding(W);
+    Stream stream(3);
+    double checksum = 0, checksumM = 0;
+    size_t allocs = g_allocs;
+    auto t0 = Clock::now();
+    for(size_t i = 0; i < N; ++i){
+        sliding.Push(stream.Next());
+        double median = sliding.Median();
+        checksum += median;
+        if( i < M )
+            checksumM += median;
+    }
+    double tHeap = Secs(t0);
+    allocs = g_allocs - allocs;
+
+    MultisetMedian reference(W);
+    stream = Stream(3);
+    double checksumRef = 0;
+    t0 = Clock::now();
+    for(size_t i = 0; i < M; ++i)
+        checksumRef += reference.Push(stream.Next());
+    double tSet = Secs(t0);
+
+    std::cout << "Mediana ventana W=" << W << ": CSlidingMedian " << N / tHeap / 1e6 << " Mops ("
+              << allocs << " new, " << sliding.getCompactions() << " compactaciones, " << sliding.getStored()
+              << " guardados), multiset " << M / tSet / 1e6 << " Mops"
+              << (checksumM == checksumRef ? "" : "  [ERROR]") << "  (checksum " << checksum << ")\n";
+}
+
+int main(int argc, char *argv[]){
+    size_t N = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000000;
+    size_t K = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    size_t W = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 10001;
+    std::cout << "N = " << N << std::fixed << std::setprecision(1) << "\n";
+    BenchTopK(N, K);
+    BenchRunningMedian(N);
+    BenchSlidingMedian(N, W);
+    return 0;
+}
@@ -31,6 +31,9 @@ struct GeneralIterator
     value_type &operator*(){
       return m_data[m_pos].GetValueRef();
     }
+    ref_type GetRef() const{
+      return m_data[m_pos].GetRef();
+    }
 };
 
 #endif // __GENERAL_ITERATOR_H__
@@ -2,6 +2,7 @@
 #define __ARRAY_H__
 #include <iostream>
 #include <assert.h>
+#include <iterator>
 using namespace std;
 #include <stddef.h>
 #include "../algorithms/sorting.h"
@@ -18,6 +19,14 @@ class ArrayForwardIterator : public GeneralIterator<Container>
 { 
   using Parent = GeneralIterator<Container>;
   public:
+    // Solo ++, + n y - (no +=, --, [] ni <): no es de acceso aleatorio.
+    // + n y - alcanzan para los Reduce/Scan paralelos (HasChunkArithmetic)
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = typename Parent::value_type;
+    using difference_type   = ptrdiff_t;
+    using pointer           = value_type *;
+    using reference         = value_type &;
+
     ArrayForwardIterator(Container *pContainer, Size pos=0)       : Parent(pContainer, pos){}
     ArrayForwardIterator(ArrayForwardIterator<Container> &another):  Parent(another){}
 
@@ -26,6 +35,10 @@ class ArrayForwardIterator : public GeneralIterator<Container>
             ++Parent::m_pos;
         return *this;
     }
+    ArrayForwardIterator<Container> operator+(difference_type delta) const
+    { return ArrayForwardIterator<Container>(Parent::m_pContainer, Parent::m_pos + delta);  }
+    difference_type operator-(const ArrayForwardIterator<Container> &another) const
+    { return Parent::m_pos - another.m_pos;  }
 };
 
 template <typename Container>
@@ -77,7 +90,7 @@ class CArray {
     //using  CompareFunc = Traits::CompareFunc
     using  CompareFunc = bool (*)(const Node &, const Node &);
   private:
-    Size m_capacity = 0, m_last = 0;
+    Size m_capacity = 0, m_last = -1;     // m_last: ultimo indice valido
     Node *m_data = nullptr;
 
   public:
@@ -111,6 +124,14 @@ class CArray {
     auto FirstThat(ObjFunc of, Args... args){
         return ::FirstThat(*this, of, args...);
     }
+    template <typename V, typename BinaryOp>
+    V Reduce(V init, BinaryOp op){
+        return ::Reduce(*this, init, op);
+    }
+    template <typename Policy, typename V, typename BinaryOp>
+    V Reduce(const Policy &policy, V init, BinaryOp op){
+        return ::Reduce(policy, *this, init, op);
+    }
     friend ostream &operator<<(ostream &os, CArray<Traits> &container){
         os << "CArray: size = " << container.getSize() << endl;
         os << "[";
@@ -132,7 +153,7 @@ CArray<Traits>::~CArray() { delete[] m_data; }
 template <typename Traits>
 typename CArray<Traits>::value_type &CArray<Traits>::operator[](Size index) {
     // cout << "XResizing from " << m_capacity << " to at least " << index + 5 << endl;
-    if (index > m_capacity) {
+    if (index >= m_capacity) {
       cout << "Resizing from " << m_capacity << " to at least " << index + 5 << endl;
       resize(index - m_last + 5);
     }
@@ -144,9 +165,9 @@ typename CArray<Traits>::value_type &CArray<Traits>::operator[](Size index) {
 
 template <typename Traits>
 void CArray<Traits>::push_back(value_type value, ref_type ref) {
-    if (m_last >= m_capacity)
+    if (m_last + 1 >= m_capacity)
       resize();
-    m_data[m_last++] = Node(value, ref);
+    m_data[++m_last] = Node(value, ref);
 }
 
 template <typename Traits>
@@ -2,8 +2,11 @@
 #define __BINARYTREE_H__
 
 #include <iostream>
+#include <string>
 #include <utility>
-#include <mutex>
+#include <vector>
+#include <iterator>
+#include <algorithm>
 #include "../general/types.h"
 #include "../util.h"
 #include "treetraits.h"
@@ -145,39 +148,87 @@ public:
     using  ForwardIterator    = CBinaryTreeForwardIterator<Traits>;
     using  CompareFunc        = typename Traits::CompareFunc;
     using  BackwardIterator   = CBinaryTreeBackwardIterator<Traits>;
+    using  LockPolicy         = typename Traits::LockPolicy;
+    using  Allocator          = typename Traits::template Allocator<Node>;
 private:
     Node *m_pRoot = nullptr;
     CompareFunc comp;
-    mutable std::recursive_mutex m_mtx;
+    LockPolicy  m_lock;         // Traits::LockPolicy (default CRecursiveLock)
+    Allocator   m_alloc;        // Traits::Allocator (default CNewAllocator)
 
 public:
     CBinaryTree(){}
     // TODO: Copy constructor
     CBinaryTree(const CBinaryTree &another);
     // TODO: Move constructor
+    // Con CNodePool el pool viaja con los nodos (los chunks no se mueven)
     CBinaryTree(CBinaryTree &&another) noexcept {
-        std::lock_guard<std::recursive_mutex> lock(another.m_mtx);
+        auto lock = another.m_lock.Write();
         m_pRoot = std::exchange(another.m_pRoot, nullptr);
+        m_alloc = std::move(another.m_alloc);
     }
     virtual ~CBinaryTree(){
-        Destroy(m_pRoot);
+        Destroy();
     }
 private:
-    void InternalInsert(Node *&rCurrent, Node *pParent, const value_type &val, ref_type ref){
-        if( !rCurrent ){
-            rCurrent = new Node(val, ref);
-            rCurrent->m_pParent = pParent;
-            return;
+    // Iterativo: baja con un puntero al enlace (sin recursion aunque el
+    // arbol degenere en una cadena, p.ej. al cargar datos ordenados)
+    void InternalInsert(const value_type &val, ref_type ref){
+        Node **ppLink = &m_pRoot, *pParent = nullptr;
+        while( *ppLink ){
+            pParent = *ppLink;
+            ppLink  = &pParent->m_pChild[ comp(val, pParent->GetValue()) ];
+        }
+        *ppLink = m_alloc.New(val, ref);
+        (*ppLink)->m_pParent = pParent;
+    }
+    // Enlace que apunta al nodo equivalente a 'value' segun CompareFunc
+    // (ni comp(value, x) ni comp(x, value)), o el enlace nulo donde iria
+    Node **FindLink(const value_type &value){
+        Node **ppLink = &m_pRoot;
+        while( *ppLink ){
+            const value_type &current = (*ppLink)->GetValueRef();
+            if( comp(value, current) )
+                ppLink = &(*ppLink)->m_pChild[1];
+            else if( comp(current, value) )
+                ppLink = &(*ppLink)->m_pChild[0];
+            else
+                break;
+        }
+        return ppLink;
+    }
+    // En in-orden 'a' va antes que 'b' cuando comp(b, a)
+    // Primer nodo que no va antes de 'value' (nullptr = end())
+    Node *LowerBoundNode(const value_type &value){
+        Node *pCurrent = m_pRoot, *pBound = nullptr;
+        while( pCurrent ){
+            if( comp(value, pCurrent->GetValueRef()) )
+                pCurrent = pCurrent->m_pChild[1];
+            else{
+                pBound   = pCurrent;
+                pCurrent = pCurrent->m_pChild[0];
+            }
         }
-        auto path = comp(val, rCurrent->GetValue());
-        InternalInsert(rCurrent->m_pChild[path], rCurrent, val, ref);
-         
+        return pBound;
+    }
+    // Primer nodo que va despues de 'value'
+    Node *UpperBoundNode(const value_type &value){
+        Node *pCurrent = m_pRoot, *pBound = nullptr;
+        while( pCurrent ){
+            if( comp(pCurrent->GetValueRef(), value) ){
+                pBound   = pCurrent;
+                pCurrent = pCurrent->m_pChild[0];
+            }
+            else
+                pCurrent = pCurrent->m_pChild[1];
+        }
+        return pBound;
     }
 
     Node* Clone(Node *pCurrent){
         if (!pCurrent)
             return nullptr;
-        Node *pNewNode = new Node(pCurrent->GetValue(),pCurrent->GetRef());
+        Node *pNewNode = m_alloc.New(pCurrent->GetValue(), pCurrent->GetRef());
         if (pCurrent->m_pChild[0]){
             pNewNode->m_pChild[0]            = Clone(pCurrent->m_pChild[0]);
             pNewNode->m_pChild[0]->m_pParent = pNewNode;
@@ -188,14 +239,77 @@ private:
         }
         return pNewNode;
     }
-    void Destroy(Node *pCurrent){
-        if (!pCurrent)
+    // Con pool y nodos triviales se liberan los chunks: O(chunks).
+    // Si no, iterativo: baja hasta una hoja, la borra y sube por m_pParent
+    void Destroy(){
+        Node *pCurrent = std::exchange(m_pRoot, nullptr);
+        if constexpr( CanBulkRelease<Allocator, Node>() )
+            m_alloc.Release();
+        else{
+            while (pCurrent){
+                if (pCurrent->m_pChild[0])
+                    pCurrent = pCurrent->m_pChild[0];
+                else if (pCurrent->m_pChild[1])
+                    pCurrent = pCurrent->m_pChild[1];
+                else{
+                    Node *pParent = pCurrent->m_pParent;
+                    if (pParent)
+                        pParent->m_pChild[ pParent->m_pChild[1] == pCurrent ] = nullptr;
+                    m_alloc.Delete(pCurrent);
+                    pCurrent = pParent;
+                }
+            }
+        }
+    }
+    // Elementos de BuildFromSorted: valor solo (ref = -1) o par (valor, ref)
+    static const value_type &KeyOf(const value_type &val){ return val; }
+    static ref_type          RefOf(const value_type &)   { return -1;  }
+    template <typename K, typename R>
+    static const K &KeyOf(const std::pair<K, R> &node){ return node.first;  }
+    template <typename K, typename R>
+    static ref_type RefOf(const std::pair<K, R> &node) { return ref_type(node.second); }
+
+    // Consume n elementos en orden: mitad izquierda, raiz, mitad derecha.
+    // Los tamanos de los dos lados difieren a lo sumo en 1 (altura
+    // floor(log2 n) + 1); la recursion tiene esa misma profundidad.
+    template <typename Iterator>
+    Node *BuildBalanced(Iterator &it, size_t n){
+        if (!n)
+            return nullptr;
+        size_t nLeft  = (n - 1) / 2;
+        Node  *pLeft  = BuildBalanced(it, nLeft);
+        Node  *pNode  = m_alloc.New(KeyOf(*it), RefOf(*it));
+        ++it;
+        Node  *pRight = BuildBalanced(it, n - 1 - nLeft);
+        pNode->m_pChild[0] = pLeft;
+        pNode->m_pChild[1] = pRight;
+        if (pLeft)
+            pLeft->m_pParent  = pNode;
+        if (pRight)
+            pRight->m_pParent = pNode;
+        return pNode;
+    }
+    // Precondicion: arbol vacio. O(n) si ya viene en orden; si no, copia y
+    // ordena (estable: los repetidos conservan su orden) y luego construye
+    template <typename Iterator>
+    void InternalBuild(Iterator begin, Iterator end){
+        auto before = [this](const auto &a, const auto &b){ return comp(KeyOf(b), KeyOf(a)); };
+        if (!std::is_sorted(begin, end, before)){
+            std::vector<typename std::iterator_traits<Iterator>::value_type> sorted(begin, end);
+            std::stable_sort(sorted.begin(), sorted.end(), before);
+            InternalBuild(sorted.begin(), sorted.end());
             return;
-        if (pCurrent->m_pChild[0])
-            Destroy(pCurrent->m_pChild[0]);
-        if (pCurrent->m_pChild[1]) 
-            Destroy(pCurrent->m_pChild[1]);
-        delete pCurrent;
+        }
+        m_pRoot = BuildBalanced(begin, size_t(std::distance(begin, end)));
+    }
+
+    // Las asignaciones arman el contenido nuevo en 'incoming' (con su
+    // propio lock y asignador) y lo intercambian aca: un lock por vez, y el
+    // arbol viejo se destruye con 'incoming', fuera del lock.
+    void SwapContents(CBinaryTree &incoming){
+        auto lock = m_lock.Write();
+        std::swap(m_pRoot, incoming.m_pRoot);
+        std::swap(m_alloc, incoming.m_alloc);
     }
 
     //ENCONTRAR EL INMEDIATO SUPERIOR (sucesor in-orden)
@@ -257,42 +371,28 @@ private:
         return InternalFirstThat(pCurrent->m_pChild[1], fn, std::forward<Args>(args)...);
     }
 
-    //REMOVE
-    void InternalRemove(Node *&pCurrent, const value_type& value){
-        if (!pCurrent)
-            return;
-        if ( value == pCurrent->GetValueRef() ){
-            //caso 1 - nodo hoja
-            if (pCurrent->m_pChild[0] == nullptr && pCurrent->m_pChild[1] == nullptr){
-                delete pCurrent;
-                pCurrent = nullptr;
-                return;
-            }
-            //caso 2a - nodo tiene solo hijo derecho
-            if (!pCurrent->m_pChild[0] && pCurrent->m_pChild[1]){
-                Node* pChild      = pCurrent->m_pChild[1];
-                pChild->m_pParent = pCurrent->m_pParent;
-                delete pCurrent;
-                pCurrent = pChild;
-                return;
-            }
-            //caso 2b - nodo tiene solo hijo izquierdo
-            if (pCurrent->m_pChild[0] && !pCurrent->m_pChild[1]){
-                Node* pChild      = pCurrent->m_pChild[0];
-                pChild->m_pParent = pCurrent->m_pParent;
-                delete pCurrent;
-                pCurrent = pChild;
-                return;
-            }
-            //caso 3 - dos hijos
-            Node* pSucc = FindMin(pCurrent->m_pChild[1]);
-            pCurrent->GetValueRef() = pSucc->GetValue();
-            pCurrent->GetRefRef()   = pSucc->GetRef();
-            InternalRemove(pCurrent->m_pChild[1], pSucc->GetValue());
+    //REMOVE (iterativo)
+    void InternalRemove(const value_type& value){
+        Node **ppLink = FindLink(value);
+        Node *pNode   = *ppLink;
+        if (!pNode)
             return;
+        //caso 3 - dos hijos: se copia el sucesor y se borra el sucesor
+        if (pNode->m_pChild[0] && pNode->m_pChild[1]){
+            Node **ppSucc = &pNode->m_pChild[1];
+            while ((*ppSucc)->m_pChild[0])
+                ppSucc = &(*ppSucc)->m_pChild[0];
+            pNode->GetValueRef() = (*ppSucc)->GetValue();
+            pNode->GetRefRef()   = (*ppSucc)->GetRef();
+            ppLink = ppSucc;
+            pNode  = *ppSucc;
         }
-        auto path = comp(value, pCurrent->GetValueRef() );
-        InternalRemove(pCurrent->m_pChild[path], value);
+        //caso 1 y 2 - hoja o un solo hijo: el hijo ocupa su lugar
+        Node *pChild = pNode->m_pChild[0] ? pNode->m_pChild[0] : pNode->m_pChild[1];
+        if (pChild)
+            pChild->m_pParent = pNode->m_pParent;
+        *ppLink = pChild;
+        m_alloc.Delete(pNode);
     }
 
     //IMPRIMIR ARBOL
@@ -306,7 +406,7 @@ private:
 
     //Operator <<
     friend std::ostream& operator<<(std::ostream& os, CBinaryTree<Traits>& BinaryTree){
-        std::lock_guard<std::recursive_mutex> lock(BinaryTree.m_mtx);
+        auto lock = BinaryTree.m_lock.Read();
         os << "CBinaryTree" << std::endl;
         os << "[";
             bool first = true;
@@ -321,54 +421,98 @@ private:
     }
 
     //Operator >>
+    // Acepta dos formatos:
+    //  - "n v1 r1 v2 r2 ..."
+    //  - el de operator<<: "CBinaryTree [v1 -> v2 -> ...]" (sin refs: quedan en -1)
+    // Sobre un arbol vacio se lee todo y se arma balanceado en O(n) si viene
+    // ordenado (el formato de operator<< siempre lo esta); si no, se ordena
+    // antes. Sobre un arbol con datos se insertan uno a uno.
     friend std::istream& operator>>(std::istream& is, CBinaryTree<Traits>& BinaryTree){
-        std::lock_guard<std::recursive_mutex> lock(BinaryTree.m_mtx);
+        auto lock = BinaryTree.m_lock.Write();
+        std::vector< std::pair<value_type, ref_type> > nodes;
+        ReadNodes(is, nodes);
+        if (!BinaryTree.m_pRoot)
+            BinaryTree.InternalBuild(nodes.begin(), nodes.end());
+        else
+            for (auto &node : nodes)
+                BinaryTree.InternalInsert(node.first, node.second);
+        return is;
+    }
+    // Lee los pares (valor, ref) en el orden del stream, de cualquiera de los dos formatos
+    static void ReadNodes(std::istream& is, std::vector< std::pair<value_type, ref_type> >& nodes){
+        is >> std::ws;
+        if (is.peek() == 'C'){
+            std::string header;
+            char        sep;
+            is >> header >> sep;
+            if (header != "CBinaryTree" || sep != '['){
+                is.setstate(std::ios::failbit);
+                return;
+            }
+            is >> std::ws;
+            if (is.peek() == ']'){
+                is.get();
+                return;
+            }
+            value_type val;
+            while (is >> val){
+                nodes.emplace_back(val, -1);
+                is >> sep;
+                if (sep == ']')
+                    break;
+                if (sep != '-' || is.get() != '>')
+                    is.setstate(std::ios::failbit);
+            }
+            return;
+        }
         size_t nElements;
-        is >> nElements;
+        if (!(is >> nElements))
+            return;
+        nodes.reserve(std::min<size_t>(nElements, size_t(1) << 24));    // n puede venir corrupto
         for (size_t i = 0; i < nElements; ++i){
             value_type val;
             ref_type   ref;
-            is >> val >> ref;
-            BinaryTree.Insert(val, ref);
+            if (!(is >> val >> ref))
+                break;
+            nodes.emplace_back(val, ref);
         }
-        return is;
     }
 
 public:
     void Insert(const value_type &val, ref_type ref){
-        std::lock_guard<std::recursive_mutex> lock(m_mtx);
-        InternalInsert(m_pRoot, nullptr, val, ref);
+        auto lock = m_lock.Write();
+        InternalInsert(val, ref);
     }
 
     template <typename Func, typename... Args>
     void Preorden(Func fn, Args ...args) {
-        std::lock_guard<std::recursive_mutex> lock(m_mtx);
+        auto lock = m_lock.Read();
         InternalPreorden(m_pRoot, fn, args...);
     }
 
     template <typename Func, typename... Args>
     void Postorden(Func fn, Args ...args) {
-        std::lock_guard<std::recursive_mutex> lock(m_mtx);
+        auto lock = m_lock.Read();
         InternalPostorden(m_pRoot, fn , args...);
     }
 
     template <typename Func, typename... Args>
     void Inorden(Func fn, Args... args) {
-        std::lock_guard<std::recursive_mutex> lock(m_mtx);
+        auto lock = m_lock.Read();
         InternalInorden(m_pRoot, fn, args...);
     }
 
     //FOREACH VARIADIC PUBLICO
     template <typename Func, typename... Args>
     void Foreach(Func fn, Args... args){
-        std::lock_guard<std::recursive_mutex> lock(m_mtx);
+        auto lock = m_lock.Read();
         InternalForeach(m_pRoot, fn, args...);
     }
 
     //FIRSTTHAT VARIADIC - PUBLICO
     template <typename Func, typename... Args>
     value_type* FirstThat(Func fn, Args... args){
-        std::lock_guard<std::recursive_mutex> lock(m_mtx);
+        auto lock = m_lock.Read();
         Node *pFound = InternalFirstThat(m_pRoot, fn, args...);
         if (pFound)
             return &pFound->GetValueRef();
@@ -377,12 +521,74 @@ public:
 
     //Remove
     void Remove(const value_type& value){
-        std::lock_guard<std::recursive_mutex> lock(m_mtx);
-        InternalRemove(m_pRoot, value);
+        auto lock = m_lock.Write();
+        InternalRemove(value);
+    }
+
+    //FIND: O(altura); nullptr si no esta
+    value_type* Find(const value_type& value){
+        auto lock = m_lock.Read();
+        Node *pFound = *FindLink(value);
+        if (pFound)
+            return &pFound->GetValueRef();
+        return nullptr;
+    }
+
+    bool Contains(const value_type& value){
+        auto lock = m_lock.Read();
+        return *FindLink(value) != nullptr;
+    }
+
+    //BUSQUEDAS ORDENADAS: bajan en O(altura) y devuelven un ForwardIterator
+    // Primer elemento que no va antes de 'value'
+    ForwardIterator LowerBound(const value_type& value){
+        auto lock = m_lock.Read();
+        return ForwardIterator(LowerBoundNode(value));
+    }
+    // Primer elemento que va despues de 'value'
+    ForwardIterator UpperBound(const value_type& value){
+        auto lock = m_lock.Read();
+        return ForwardIterator(UpperBoundNode(value));
+    }
+    // [LowerBound, UpperBound): todos los equivalentes a 'value'
+    std::pair<ForwardIterator, ForwardIterator> EqualRange(const value_type& value){
+        auto lock = m_lock.Read();
+        return {ForwardIterator(LowerBoundNode(value)), ForwardIterator(UpperBoundNode(value))};
+    }
+
+    //FOREACH EN RANGO [lo, hi]: O(altura + k), solo toca los k del resultado
+    template <typename Func, typename... Args>
+    size_t ForeachInRange(const value_type& lo, const value_type& hi, Func fn, Args... args){
+        auto lock = m_lock.Read();
+        size_t visited = 0;
+        if (comp(lo, hi))               // lo va despues de hi: rango vacio
+            return visited;
+        ForwardIterator last(UpperBoundNode(hi));
+        for (ForwardIterator it(LowerBoundNode(lo)); it != last; ++it, ++visited)
+            fn(*it, args...);
+        return visited;
+    }
+
+    //CONSTRUCCION EN BLOQUE: reemplaza el contenido por [begin, end) en un
+    // arbol perfectamente balanceado. O(n) si ya viene en orden (una pasada
+    // para verificarlo y otra para armar); si no, O(n log n) ordenando una
+    // copia. *it es value_type (ref = -1) o std::pair<value_type, ref_type>.
+    // Iteradores forward (se recorren dos veces).
+    template <typename Iterator>
+    void BuildFromSorted(Iterator begin, Iterator end){
+        auto lock = m_lock.Write();
+        Destroy();
+        InternalBuild(begin, end);
+    }
+
+    // Con CNodePool (TreeTraitAscendingPool, ...) es O(chunks)
+    void Clear(){
+        auto lock = m_lock.Write();
+        Destroy();
     }
 
     void PrintTree(){
-        std::lock_guard<std::recursive_mutex> lock(m_mtx);
+        auto lock = m_lock.Read();
         if (!m_pRoot) { std::cout << "(arbol vacio)\n"; return; }
         InternalPrintTree(m_pRoot, 0);
     }
@@ -429,20 +635,19 @@ CBinaryTree<Traits>::rend(){ return BackwardIterator(nullptr); }
 //Copy Constructor
 template <typename Traits>
 CBinaryTree<Traits>::CBinaryTree(const CBinaryTree<Traits> &another){
-    std::lock_guard<std::recursive_mutex> lock(another.m_mtx);
+    auto lock = another.m_lock.Read();
     m_pRoot = Clone(another.m_pRoot);
 }
 
+// Las asignaciones toman un lock por vez (nunca los dos juntos): a = b y
+// b = a en paralelo no pueden trabarse (ver SwapContents).
 //Operador de asignación '=' para copy constructor
 template <typename Traits>
 CBinaryTree<Traits>& CBinaryTree<Traits>::operator=(const CBinaryTree& another){
     if (this == &another)
         return *this;
-    std::lock(m_mtx, another.m_mtx);
-    std::lock_guard<std::recursive_mutex> lock1(m_mtx, std::adopt_lock);
-    std::lock_guard<std::recursive_mutex> lock2(another.m_mtx, std::adopt_lock);
-    Destroy(m_pRoot);
-    m_pRoot = Clone(another.m_pRoot);
+    CBinaryTree incoming(another);
+    SwapContents(incoming);
     return *this;
 }
 //Operador de asignación '=' para move constructor
@@ -450,12 +655,8 @@ template <typename Traits>
 CBinaryTree<Traits>& CBinaryTree<Traits>::operator=(CBinaryTree<Traits>&& another) noexcept{
     if (this == &another)
         return *this;
-    std::lock(m_mtx, another.m_mtx);
-    std::lock_guard<std::recursive_mutex> lock1(m_mtx, std::adopt_lock);
-    std::lock_guard<std::recursive_mutex> lock2(another.m_mtx, std::adopt_lock);
-    Destroy(m_pRoot);
-    m_pRoot = std::exchange(another.m_pRoot,nullptr);
+    CBinaryTree incoming(std::move(another));
+    SwapContents(incoming);
     return *this;
-
 }
-#endif // __BINARYTREE_H__
\ No newline at end of file
+#endif // __BINARYTREE_H__
@@ -0,0 +1,223 @@
+#ifndef __CONCURRENTBINARYTREE_H__
+#define __CONCURRENTBINARYTREE_H__
+
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "../general/types.h"
+#include "treetraits.h"
+
+// Arbol binario de busqueda con un mutex por nodo (lock coupling).
+//  - Mismo orden y semantica que CBinaryTree<Traits>: admite repetidos
+//    (van a la izquierda) y Remove borra uno de los equivalentes.
+//    Traits::LockPolicy no se usa: el bloqueo es por nodo.
+//  - Insert, Remove, Contains y Find bajan "mano sobre mano": se toma el
+//    lock del hijo antes de soltar el del padre. Todos toman los locks de
+//    arriba hacia abajo, asi que no hay ciclos (ni deadlock) y dos
+//    operaciones en subarboles disjuntos avanzan en paralelo despues de
+//    separarse. El enlace a la raiz lo protege el lock de m_head.
+//  - Para llegar a un nodo hay que tener el lock de su padre: quien
+//    desenlaza un nodo teniendo ambos locks sabe que nadie mas lo ve ni lo
+//    espera, y lo puede borrar enseguida (sin epocas).
+//  - Remove con dos hijos: se mantiene el lock del nodo mientras se baja
+//    al sucesor (minimo del subarbol derecho), se copia el sucesor en el
+//    nodo y se desenlaza el sucesor. Quien venga detras espera en el nodo
+//    y ya ve el valor nuevo; quien iba delante sigue en el subarbol derecho,
+//    donde el orden no cambio.
+//  - No hay puntero al padre (subir romperia el orden de los locks).
+//  - Foreach y operator<< no toman locks: solo sin escritores concurrentes.
+template <typename Traits>
+class NodeConcurrentBinaryTree{
+    using  value_type  = typename Traits::value_type;
+    using  Node        = NodeConcurrentBinaryTree<Traits>;
+private:
+    value_type m_data;
+    ref_type   m_ref;
+public:
+    Node       *m_pChild[2] = {nullptr, nullptr};
+    std::mutex  m_mtx;
+
+    NodeConcurrentBinaryTree(){}
+    NodeConcurrentBinaryTree(const value_type &_value, ref_type _ref = -1)
+        : m_data(_value), m_ref(_ref){   }
+    value_type  GetValue   () const { return m_data; }
+    value_type &GetValueRef()       { return m_data; }
+    ref_type    GetRef     () const { return m_ref;  }
+    ref_type   &GetRefRef  ()       { return m_ref;  }
+};
+
+template <typename Traits>
+class CConcurrentBinaryTree {
+public:
+    using  value_type  = typename Traits::value_type;
+    using  Node        = NodeConcurrentBinaryTree<Traits>;
+    using  CompareFunc = typename Traits::CompareFunc;
+private:
+    Node                 m_head;            // centinela: m_pChild[0] es la raiz
+    std::atomic<size_t>  m_nElements{0};
+    CompareFunc          comp;
+public:
+    CConcurrentBinaryTree(){}
+    CConcurrentBinaryTree(const CConcurrentBinaryTree &) = delete;
+    CConcurrentBinaryTree &operator=(const CConcurrentBinaryTree &) = delete;
+    virtual ~CConcurrentBinaryTree();
+
+    void Insert(const value_type &val, ref_type ref);
+    // false si no habia ningun equivalente a 'val'
+    bool Remove(const value_type &val);
+    bool Contains(const value_type &val);
+    // Copia la ref del nodo encontrado (el nodo puede borrarse despues)
+    bool Find(const value_type &val, ref_type &ref);
+    size_t getSize(){ return m_nElements.load(std::memory_order_relaxed); }
+
+    // In-orden sin locks. Requiere que NO haya escritores concurrentes:
+    // Remove borra los nodos en el acto (no hay epocas como en
+    // CConcurrentLinkedList), asi que recorrer mientras otro hilo borra es
+    // una carrera de datos y un uso de memoria liberada. Idem operator<<.
+    template <typename Func, typename... Args>
+    void Foreach(Func fn, Args... args){
+        std::vector<Node *> stack;
+        Node *pCurrent = m_head.m_pChild[0];
+        while( pCurrent || !stack.empty() ){
+            for(; pCurrent; pCurrent = pCurrent->m_pChild[0])
+                stack.push_back(pCurrent);
+            pCurrent = stack.back();
+            stack.pop_back();
+            fn(pCurrent->GetValueRef(), args...);
+            pCurrent = pCurrent->m_pChild[1];
+        }
+    }
+private:
+    // Baja con lock coupling hasta el nodo equivalente a 'val'. Si lo
+    // encuentra deja bloqueados pParent y pNode (ppLink es el enlace de
+    // pParent a pNode); si no, solo pParent, con *ppLink == nullptr.
+    void LockedFind(const value_type &val, Node *&pParent, Node **&ppLink);
+
+    friend std::ostream &operator<<(std::ostream &os, CConcurrentBinaryTree<Traits> &container){
+        os << "CConcurrentBinaryTree: size = " << container.getSize() << std::endl;
+        os << "[";
+        container.Foreach([&os](value_type &value){ os << value << ","; });
+        os << "]" << std::endl;
+        return os;
+    }
+};
+
+// Sin hilos activos: iterativo con una pila de pendientes
+template <typename Traits>
+CConcurrentBinaryTree<Traits>::~CConcurrentBinaryTree(){
+    std::vector<Node *> pending;
+    if( m_head.m_pChild[0] )
+        pending.push_back(m_head.m_pChild[0]);
+    while( !pending.empty() ){
+        Node *pNode = pending.back();
+        pending.pop_back();
+        for(Node *pChild : pNode->m_pChild)
+            if( pChild )
+                pending.push_back(pChild);
+        delete pNode;
+    }
+}
+
+template <typename Traits>
+void CConcurrentBinaryTree<Traits>::Insert(const value_type &val, ref_type ref){
+    Node *pNew    = new Node(val, ref);      // fuera de los locks
+    Node *pParent = &m_head;
+    pParent->m_mtx.lock();
+    Node **ppLink = &m_head.m_pChild[0];
+    while( Node *pChild = *ppLink ){
+        pChild->m_mtx.lock();
+        pParent->m_mtx.unlock();
+        pParent = pChild;
+        ppLink  = &pChild->m_pChild[ comp(val, pChild->GetValueRef()) ];
+    }
+    *ppLink = pNew;
+    pParent->m_mtx.unlock();
+    m_nElements.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename Traits>
+void CConcurrentBinaryTree<Traits>::LockedFind(const value_type &val, Node *&pParent, Node **&ppLink){
+    pParent = &m_head;
+    pParent->m_mtx.lock();
+    ppLink = &m_head.m_pChild[0];
+    while( Node *pNode = *ppLink ){
+        pNode->m_mtx.lock();
+        const value_type &current = pNode->GetValueRef();
+        int path;
+        if( comp(val, current) )
+            path = 1;
+        else if( comp(current, val) )
+            path = 0;
+        else
+            return;                         // pParent y pNode bloqueados
+        pParent->m_mtx.unlock();
+        pParent = pNode;
+        ppLink  = &pNode->m_pChild[path];
+    }
+}
+
+template <typename Traits>
+bool CConcurrentBinaryTree<Traits>::Remove(const value_type &val){
+    Node *pParent, **ppLink;
+    LockedFind(val, pParent, ppLink);
+    Node *pNode = *ppLink;
+    if( !pNode ){
+        pParent->m_mtx.unlock();
+        return false;
+    }
+    if( !pNode->m_pChild[0] || !pNode->m_pChild[1] ){
+        // hoja o un solo hijo: el hijo ocupa su lugar
+        *ppLink = pNode->m_pChild[0] ? pNode->m_pChild[0] : pNode->m_pChild[1];
+        pNode->m_mtx.unlock();
+        pParent->m_mtx.unlock();
+        delete pNode;
+    }
+    else{
+        // dos hijos: pNode queda en su lugar (bloqueado) y recibe el sucesor
+        pParent->m_mtx.unlock();
+        Node  *pSuccParent = pNode;
+        Node **ppSucc      = &pNode->m_pChild[1];
+        Node  *pSucc       = *ppSucc;
+        pSucc->m_mtx.lock();
+        while( Node *pLeft = pSucc->m_pChild[0] ){
+            pLeft->m_mtx.lock();
+            if( pSuccParent != pNode )
+                pSuccParent->m_mtx.unlock();
+            pSuccParent = pSucc;
+            ppSucc      = &pSucc->m_pChild[0];
+            pSucc       = pLeft;
+        }
+        pNode->GetValueRef() = pSucc->GetValue();
+        pNode->GetRefRef()   = pSucc->GetRef();
+        *ppSucc = pSucc->m_pChild[1];
+        pSucc->m_mtx.unlock();
+        if( pSuccParent != pNode )
+            pSuccParent->m_mtx.unlock();
+        pNode->m_mtx.unlock();
+        delete pSucc;
+    }
+    m_nElements.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename Traits>
+bool CConcurrentBinaryTree<Traits>::Find(const value_type &val, ref_type &ref){
+    Node *pParent, **ppLink;
+    LockedFind(val, pParent, ppLink);
+    Node *pNode = *ppLink;
+    if( pNode ){
+        ref = pNode->GetRef();
+        pNode->m_mtx.unlock();
+    }
+    pParent->m_mtx.unlock();
+    return pNode != nullptr;
+}
+
+template <typename Traits>
+bool CConcurrentBinaryTree<Traits>::Contains(const value_type &val){
+    ref_type ref;
+    return Find(val, ref);
+}
+
+#endif // __CONCURRENTBINARYTREE_H__
@@ -0,0 +1,176 @@
+#ifndef __CONCURRENTLIST_H__
+#define __CONCURRENTLIST_H__
+#include <iostream>
+#include <atomic>
+#include <cstdint>
+#include "../general/types.h"
+#include "linkedlist.h"
+#include "epoch.h"
+
+// Lista enlazada ordenada lock-free (Harris / Michael).
+//  - Conjunto ordenado segun Traits::Func: no admite valores repetidos.
+//  - Insert, Remove y Contains pueden llamarse desde cualquier hilo.
+//  - Remove marca el bit bajo del m_next del nodo (borrado logico) y luego
+//    lo desenlaza; cualquier hilo que encuentre un nodo marcado ayuda a
+//    desenlazarlo. El que lo desenlaza lo entrega al CEpochReclaimer.
+template <typename Traits>
+class NodeConcurrentList{
+    using  value_type  = typename Traits::value_type;
+    using  Node        = NodeConcurrentList<Traits>;
+private:
+    value_type m_data;
+    ref_type   m_ref;
+public:
+    std::atomic<uintptr_t> m_next{0};    // puntero | bit de borrado
+
+    NodeConcurrentList(){}
+    NodeConcurrentList(const value_type &_value, ref_type _ref = -1)
+        : m_data(_value), m_ref(_ref){   }
+    value_type  GetValue   () const { return m_data; }
+    ref_type    GetRef     () const { return m_ref;  }
+
+    static Node     *Pointer(uintptr_t link)        { return reinterpret_cast<Node *>(link & ~uintptr_t(1)); }
+    static bool      IsMarked(uintptr_t link)       { return link & 1; }
+    static uintptr_t Link(Node *pNode, bool marked = false)
+    { return reinterpret_cast<uintptr_t>(pNode) | uintptr_t(marked); }
+};
+
+template <typename Traits>
+class CConcurrentLinkedList {
+public:
+    using  value_type  = typename Traits::value_type;
+    using  Node        = NodeConcurrentList<Traits>;
+    using  Func        = typename Traits::Func;
+private:
+    Node                 m_head;            // centinela
+    std::atomic<size_t>  m_nElements{0};
+    CEpochReclaimer     &m_reclaimer = CEpochReclaimer::Instance();
+    Func                 comp;
+public:
+    CConcurrentLinkedList(){}
+    CConcurrentLinkedList(const CConcurrentLinkedList &) = delete;
+    CConcurrentLinkedList &operator=(const CConcurrentLinkedList &) = delete;
+    virtual ~CConcurrentLinkedList();
+
+    bool Insert(const value_type &val, ref_type ref);
+    bool Remove(const value_type &val);
+    bool Contains(const value_type &val);
+    size_t getSize(){ return m_nElements.load(std::memory_order_relaxed);  }
+
+    // Recorrido en orden: solo es exacto si no hay escritores concurrentes
+    template <typename Func2, typename... Args>
+    void Foreach(Func2 fn, Args... args){
+        CEpochGuard guard(m_reclaimer);
+        for(Node *pNode = Node::Pointer(m_head.m_next.load()); pNode;
+            pNode = Node::Pointer(pNode->m_next.load()))
+            if( !Node::IsMarked(pNode->m_next.load()) )
+                fn(pNode->GetValue(), args...);
+    }
+private:
+    bool Before(const value_type &a, const value_type &b) const { return comp(b, a); }
+    bool Equal (const value_type &a, const value_type &b) const { return !comp(a, b) && !comp(b, a); }
+
+    // Devuelve pPred y pCurr con pCurr = primer nodo no marcado que no va
+    // antes de 'val' (o nullptr). Desenlaza los marcados que encuentra.
+    void Find(const value_type &val, Node *&pPred, Node *&pCurr);
+
+    friend ostream &operator<<(ostream &os, CConcurrentLinkedList<Traits> &container){
+        os << "CConcurrentLinkedList: size = " << container.getSize() << endl;
+        os << "[";
+        container.Foreach([&os](const value_type &value){ os << value << ","; });
+        os << "]" << endl;
+        return os;
+    }
+};
+
+template <typename Traits>
+CConcurrentLinkedList<Traits>::~CConcurrentLinkedList(){
+    Node *pNode = Node::Pointer(m_head.m_next.load());
+    while( pNode ){
+        Node *pNext = Node::Pointer(pNode->m_next.load());
+        delete pNode;
+        pNode = pNext;
+    }
+}
+
+template <typename Traits>
+void CConcurrentLinkedList<Traits>::Find(const value_type &val, Node *&pPred, Node *&pCurr){
+retry:
+    pPred = &m_head;
+    pCurr = Node::Pointer(pPred->m_next.load());
+    while( pCurr ){
+        uintptr_t succ = pCurr->m_next.load();
+        if( Node::IsMarked(succ) ){
+            // pCurr esta borrado: ayudar a desenlazarlo
+            uintptr_t expected = Node::Link(pCurr);
+            if( !pPred->m_next.compare_exchange_strong(expected, Node::Link(Node::Pointer(succ))) )
+                goto retry;
+            m_reclaimer.Retire(pCurr);
+            pCurr = Node::Pointer(succ);
+            continue;
+        }
+        if( !Before(pCurr->GetValue(), val) )
+            return;
+        pPred = pCurr;
+        pCurr = Node::Pointer(succ);
+    }
+}
+
+template <typename Traits>
+bool CConcurrentLinkedList<Traits>::Insert(const value_type &val, ref_type ref){
+    CEpochGuard guard(m_reclaimer);
+    Node *pNew = nullptr;
+    while( true ){
+        Node *pPred, *pCurr;
+        Find(val, pPred, pCurr);
+        if( pCurr && Equal(pCurr->GetValue(), val) ){
+            delete pNew;                // nunca fue publicado
+            return false;
+        }
+        if( !pNew )
+            pNew = new Node(val, ref);
+        pNew->m_next.store(Node::Link(pCurr), std::memory_order_relaxed);
+        uintptr_t expected = Node::Link(pCurr);
+        if( pPred->m_next.compare_exchange_strong(expected, Node::Link(pNew)) ){
+            m_nElements.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+template <typename Traits>
+bool CConcurrentLinkedList<Traits>::Remove(const value_type &val){
+    CEpochGuard guard(m_reclaimer);
+    while( true ){
+        Node *pPred, *pCurr;
+        Find(val, pPred, pCurr);
+        if( !pCurr || !Equal(pCurr->GetValue(), val) )
+            return false;
+        uintptr_t succ = pCurr->m_next.load();
+        if( Node::IsMarked(succ) )
+            continue;
+        // 1) borrado logico: solo un hilo gana este CAS
+        if( !pCurr->m_next.compare_exchange_strong(succ, succ | 1) )
+            continue;
+        m_nElements.fetch_sub(1, std::memory_order_relaxed);
+        // 2) borrado fisico; si falla, Find lo desenlaza
+        uintptr_t expected = Node::Link(pCurr);
+        if( pPred->m_next.compare_exchange_strong(expected, succ) )
+            m_reclaimer.Retire(pCurr);
+        else
+            Find(val, pPred, pCurr);
+        return true;
+    }
+}
+
+// Sin escrituras: solo recorre (wait-free respecto a la longitud)
+template <typename Traits>
+bool CConcurrentLinkedList<Traits>::Contains(const value_type &val){
+    CEpochGuard guard(m_reclaimer);
+    Node *pCurr = Node::Pointer(m_head.m_next.load());
+    while( pCurr && Before(pCurr->GetValue(), val) )
+        pCurr = Node::Pointer(pCurr->m_next.load());
+    return pCurr && Equal(pCurr->GetValue(), val) && !Node::IsMarked(pCurr->m_next.load());
+}
+
+#endif // __CONCURRENTLIST_H__
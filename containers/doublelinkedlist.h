@@ -2,19 +2,273 @@
 #define __DOUBLE_LINKED_LIST_H__
 
 #include <iostream>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
 #include "../general/types.h"
 #include "../util.h"
+#include "linkedlist.h"
 using namespace std;
 
-// TODO: ForwardIterator para listas doblemente enlazadas
+// Lista doblemente enlazada compacta:
+//  - Todos los nodos viven en un solo std::vector y se enlazan por indices
+//    de 32 bits (8 bytes de enlaces por nodo en vez de 16).
+//  - El indice 0 es un centinela circular: Front() = Next(End), Back() = Prev(End).
+//  - Un indice (handle) es estable mientras no se llame a Compact().
+//  - Los nodos borrados van a una free list y se reutilizan.
+// Usa los mismos Traits que CLinkedList (Func solo se usa en Insert ordenado).
+template <typename Traits>
+class NodeDoubleLinkedList{
+    using  value_type  = typename Traits::value_type;
+    using  Node        = NodeDoubleLinkedList<Traits>;
+    template <typename> friend class CDoubleLinkedList;
+private:
+    value_type m_data;
+    ref_type   m_ref  = -1;
+    uint32_t   m_prev = 0;
+    uint32_t   m_next = 0;      // en la free list: siguiente libre
+public:
+    NodeDoubleLinkedList(){}
+    NodeDoubleLinkedList(const value_type &_value, ref_type _ref, uint32_t prev, uint32_t next)
+        : m_data(_value), m_ref(_ref), m_prev(prev), m_next(next){   }
+    value_type  GetValue   () const { return m_data; }
+    value_type &GetValueRef()       { return m_data; }
+    ref_type    GetRef     () const { return m_ref;  }
+};
+
+// Iterators para listas doblemente enlazadas (Forward = true: Front -> Back)
+template <typename Container, bool Forward>
+class DoubleLinkedListIterator{
+public:
+    using value_type = typename Container::value_type;
+private:
+    using Iterator   = DoubleLinkedListIterator<Container, Forward>;
+    Container *m_pContainer = nullptr;
+    uint32_t   m_pos        = 0;
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = ptrdiff_t;
+    using pointer           = value_type *;
+    using reference         = value_type &;
 
-// TODO: BackwardIterator para listas doblemente enlazadas
+    DoubleLinkedListIterator(Container *pContainer, uint32_t pos)
+        : m_pContainer(pContainer), m_pos(pos){}
+    value_type &operator*()                        { return m_pContainer->GetValueRef(m_pos); }
+    ref_type    GetRef()    const                  { return m_pContainer->GetRef(m_pos);      }
+    uint32_t    GetHandle() const                  { return m_pos; }
+    bool operator!=(const Iterator &another) const { return m_pos != another.m_pos; }
+    bool operator==(const Iterator &another) const { return m_pos == another.m_pos; }
+    Iterator &operator++(){
+        m_pos = Forward ? m_pContainer->Next(m_pos) : m_pContainer->Prev(m_pos);
+        return *this;
+    }
+    Iterator &operator--(){
+        m_pos = Forward ? m_pContainer->Prev(m_pos) : m_pContainer->Next(m_pos);
+        return *this;
+    }
+};
 
 template <typename Traits>
-class NodeDoubleLinkedList{
-    // using  value_type  = typename Traits::value_type;
-    // using  Node        = NodeDoubleLinkedList<Traits>;
+class CDoubleLinkedList {
+public:
+    using  value_type  = typename Traits::value_type;
+    using  Node        = NodeDoubleLinkedList<Traits>;
+    using  Func        = typename Traits::Func;
+    using  handle      = uint32_t;
+    using  forward_iterator  = DoubleLinkedListIterator< CDoubleLinkedList<Traits>, true  >;
+    using  backward_iterator = DoubleLinkedListIterator< CDoubleLinkedList<Traits>, false >;
+    static constexpr handle End  = 0;            // centinela
+    static constexpr handle npos = UINT32_MAX;   // free list vacia
+private:
+    std::vector<Node> m_nodes;
+    handle  m_free      = npos;
+    size_t  m_nElements = 0;
+public:
+    CDoubleLinkedList() : m_nodes(1){}
+    CDoubleLinkedList(const CDoubleLinkedList &another) = default;
+    // El origen queda vacio pero usable: necesita su propio centinela, que
+    // se pide antes de tocarlo (puede lanzar bad_alloc: no es noexcept)
+    CDoubleLinkedList(CDoubleLinkedList &&another) : m_nodes(1){
+        Swap(another);
+    }
+    CDoubleLinkedList &operator=(const CDoubleLinkedList &another) = default;
+    // Los nodos viejos se liberan con 'incoming'
+    CDoubleLinkedList &operator=(CDoubleLinkedList &&another){
+        if( this != &another ){
+            CDoubleLinkedList incoming(std::move(another));
+            Swap(incoming);
+        }
+        return *this;
+    }
+    void Swap(CDoubleLinkedList &another) noexcept{
+        m_nodes.swap(another.m_nodes);
+        std::swap(m_free, another.m_free);
+        std::swap(m_nElements, another.m_nElements);
+    }
+    virtual ~CDoubleLinkedList(){}
+
+    handle push_front(const value_type &val, ref_type ref){ return insert(Front(), val, ref); }
+    handle push_back (const value_type &val, ref_type ref){ return insert(End,     val, ref); }
+    // Inserta antes de 'pos' (End = al final) y devuelve el handle del nuevo nodo
+    handle insert(handle pos, const value_type &val, ref_type ref);
+    // Insert ordenado segun Func; los iguales quedan en orden de llegada
+    handle Insert(const value_type &val, ref_type ref);
+
+    void   erase(handle pos);
+    void   pop_front(){ erase(Front()); }
+    void   pop_back (){ erase(Back());  }
 
+    // Mueve 'node' antes de 'pos' sin copiar: O(1)
+    void   splice(handle pos, handle node);
+    // Mueve el rango [first, last) antes de 'pos' (pos fuera del rango): O(1)
+    void   splice(handle pos, handle first, handle last);
+    void   MoveToFront(handle node){ splice(Front(), node); }
+    void   MoveToBack (handle node){ splice(End,     node); }
+
+    // Reubica los nodos en orden de recorrido y descarta los libres.
+    // Los handles cambian: onMove(viejo, nuevo) se llama por cada nodo.
+    template <typename F>
+    void   Compact(F onMove);
+    void   Compact(){ Compact([](handle, handle){}); }
+
+    void   Clear();
+    void   reserve(size_t n){ m_nodes.reserve(n + 1); }
+
+    handle Front() const           { return m_nodes[End].m_next;  }
+    handle Back () const           { return m_nodes[End].m_prev;  }
+    handle Next (handle pos) const { return m_nodes[pos].m_next;  }
+    handle Prev (handle pos) const { return m_nodes[pos].m_prev;  }
+    value_type  GetValue   (handle pos) const { return m_nodes[pos].m_data; }
+    value_type &GetValueRef(handle pos)       { return m_nodes[pos].m_data; }
+    ref_type    GetRef     (handle pos) const { return m_nodes[pos].m_ref;  }
+
+    size_t getSize()     const { return m_nElements;          }
+    size_t getCapacity() const { return m_nodes.size() - 1;   }
+    size_t getBytes()    const { return m_nodes.capacity() * sizeof(Node); }
+    bool   empty()       const { return m_nElements == 0;     }
+
+    forward_iterator  begin()  { return forward_iterator (this, Front()); }
+    forward_iterator  end()    { return forward_iterator (this, End);     }
+    backward_iterator rbegin() { return backward_iterator(this, Back());  }
+    backward_iterator rend()   { return backward_iterator(this, End);     }
+private:
+    handle NewNode(const value_type &val, ref_type ref, handle prev, handle next);
+    // Desenlaza sin liberar
+    void   Unlink(handle pos){
+        m_nodes[m_nodes[pos].m_prev].m_next = m_nodes[pos].m_next;
+        m_nodes[m_nodes[pos].m_next].m_prev = m_nodes[pos].m_prev;
+    }
+    // Enlaza [first, last] antes de 'pos'
+    void   Link(handle pos, handle first, handle last){
+        handle prev = m_nodes[pos].m_prev;
+        m_nodes[first].m_prev = prev;
+        m_nodes[last ].m_next = pos;
+        m_nodes[prev ].m_next = first;
+        m_nodes[pos  ].m_prev = last;
+    }
+
+    friend ostream &operator<<(ostream &os, CDoubleLinkedList<Traits> &container){
+        os << "CDoubleLinkedList: size = " << container.getSize() << endl;
+        os << "[";
+        for(auto iter = container.begin(); iter != container.end(); ++iter)
+            os << "(" << *iter << ":" << iter.GetRef() << "),";
+        os << "]" << endl;
+        return os;
+    }
 };
 
-#endif // __DOUBLE_LINKED_LIST_H__
\ No newline at end of file
+template <typename Traits>
+typename CDoubleLinkedList<Traits>::handle
+CDoubleLinkedList<Traits>::NewNode(const value_type &val, ref_type ref, handle prev, handle next){
+    handle pos;
+    if( m_free != npos ){
+        pos    = m_free;
+        m_free = m_nodes[pos].m_next;
+        m_nodes[pos] = Node(val, ref, prev, next);
+    }
+    else{
+        pos = handle(m_nodes.size());
+        m_nodes.emplace_back(val, ref, prev, next);
+    }
+    return pos;
+}
+
+template <typename Traits>
+typename CDoubleLinkedList<Traits>::handle
+CDoubleLinkedList<Traits>::insert(handle pos, const value_type &val, ref_type ref){
+    handle node = NewNode(val, ref, m_nodes[pos].m_prev, pos);
+    m_nodes[m_nodes[node].m_prev].m_next = node;
+    m_nodes[pos].m_prev = node;
+    ++m_nElements;
+    return node;
+}
+
+template <typename Traits>
+typename CDoubleLinkedList<Traits>::handle
+CDoubleLinkedList<Traits>::Insert(const value_type &val, ref_type ref){
+    Func comp;
+    // Desde el final: la carga casi ordenada es O(1)
+    handle pos = End;
+    while( m_nodes[pos].m_prev != End && comp(m_nodes[m_nodes[pos].m_prev].m_data, val) )
+        pos = m_nodes[pos].m_prev;
+    return insert(pos, val, ref);
+}
+
+template <typename Traits>
+void CDoubleLinkedList<Traits>::erase(handle pos){
+    if( pos == End )
+        return;
+    Unlink(pos);
+    m_nodes[pos].m_data = value_type();     // suelta recursos del valor
+    m_nodes[pos].m_next = m_free;
+    m_free = pos;
+    --m_nElements;
+}
+
+template <typename Traits>
+void CDoubleLinkedList<Traits>::splice(handle pos, handle node){
+    if( node == End || node == pos )
+        return;
+    Unlink(node);
+    Link(pos, node, node);
+}
+
+template <typename Traits>
+void CDoubleLinkedList<Traits>::splice(handle pos, handle first, handle last){
+    if( first == last || pos == last )
+        return;
+    handle back = m_nodes[last].m_prev;
+    m_nodes[m_nodes[first].m_prev].m_next = last;
+    m_nodes[last].m_prev = m_nodes[first].m_prev;
+    Link(pos, first, back);
+}
+
+template <typename Traits>
+template <typename F>
+void CDoubleLinkedList<Traits>::Compact(F onMove){
+    std::vector<Node> nodes;
+    nodes.reserve(m_nElements + 1);
+    nodes.emplace_back();
+    handle n = 0;
+    for(handle pos = Front(); pos != End; pos = m_nodes[pos].m_next){
+        ++n;
+        nodes.emplace_back(std::move(m_nodes[pos].m_data), m_nodes[pos].m_ref, n - 1, n + 1);
+        onMove(pos, n);
+    }
+    nodes[End].m_next = n ? 1 : End;
+    nodes[End].m_prev = n;
+    if( n )
+        nodes[n].m_next = End;
+    m_nodes.swap(nodes);
+    m_free = npos;
+}
+
+template <typename Traits>
+void CDoubleLinkedList<Traits>::Clear(){
+    m_nodes.assign(1, Node());
+    m_free      = npos;
+    m_nElements = 0;
+}
+
+#endif // __DOUBLE_LINKED_LIST_H__
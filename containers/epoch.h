@@ -0,0 +1,158 @@
+#ifndef __EPOCH_H__
+#define __EPOCH_H__
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+// Reclamacion de memoria por epocas (EBR) para estructuras lock-free.
+//  - Un hilo que va a leer nodos compartidos crea un CEpochGuard (pin).
+//  - Un nodo ya desenlazado se entrega a Retire(); se libera recien cuando
+//    la epoca global avanzo 2 veces, es decir, cuando ningun hilo que pudo
+//    verlo sigue dentro de su seccion critica.
+// Es un singleton de proceso: todas las estructuras comparten los registros.
+class CEpochReclaimer{
+public:
+    static constexpr unsigned MaxThreads  = 256;
+    static constexpr unsigned CollectEach = 64;     // retiros entre intentos de avanzar
+private:
+    static constexpr uint64_t kIdle = UINT64_MAX;
+
+    struct Retired{
+        void  *m_p;
+        void (*m_pDeleter)(void *);
+    };
+    struct alignas(64) Record{
+        std::atomic<uint64_t> m_epoch{kIdle};   // epoca fijada o kIdle
+        std::atomic<bool>     m_used{false};
+        unsigned              m_nesting  = 0;
+        unsigned              m_nRetired = 0;
+        std::vector<Retired>  m_limbo[3];       // un bucket por epoca (mod 3)
+        uint64_t              m_limboEpoch[3] = {0, 0, 0};
+    };
+    struct ThreadHandle{
+        Record *m_pRecord = nullptr;
+        ~ThreadHandle(){
+            // Lo pendiente queda en el registro: lo libera el proximo dueno
+            if( m_pRecord )
+                m_pRecord->m_used.store(false, std::memory_order_release);
+        }
+    };
+
+    alignas(64) std::atomic<uint64_t> m_globalEpoch{2};
+    Record m_records[MaxThreads];
+
+    CEpochReclaimer(){}
+public:
+    CEpochReclaimer(const CEpochReclaimer &) = delete;
+    CEpochReclaimer &operator=(const CEpochReclaimer &) = delete;
+    ~CEpochReclaimer(){
+        for(auto &record : m_records)
+            for(auto &bucket : record.m_limbo)
+                Free(bucket);
+    }
+
+    static CEpochReclaimer &Instance(){
+        static CEpochReclaimer reclaimer;
+        return reclaimer;
+    }
+
+    void Pin(){
+        Record &rec = Self();
+        if( rec.m_nesting++ )
+            return;
+        // seq_cst: la epoca publicada queda ordenada con los CAS de la estructura
+        uint64_t epoch = m_globalEpoch.load(), current;
+        while( true ){
+            rec.m_epoch.store(epoch);
+            if( (current = m_globalEpoch.load()) == epoch )
+                break;
+            epoch = current;
+        }
+    }
+    void Unpin(){
+        Record &rec = Self();
+        if( --rec.m_nesting )
+            return;
+        rec.m_epoch.store(kIdle, std::memory_order_release);
+    }
+
+    // Debe llamarse con el hilo fijado (dentro de un CEpochGuard)
+    template <typename Node>
+    void Retire(Node *pNode){
+        Retire(pNode, [](void *p){ delete static_cast<Node *>(p); });
+    }
+    void Retire(void *p, void (*pDeleter)(void *)){
+        Record  &rec   = Self();
+        uint64_t epoch = m_globalEpoch.load();
+        unsigned b     = epoch % 3;
+        if( rec.m_limboEpoch[b] != epoch ){
+            // El bucket tiene nodos de epoca <= epoch-3: ya son seguros
+            Free(rec.m_limbo[b]);
+            rec.m_limboEpoch[b] = epoch;
+        }
+        rec.m_limbo[b].push_back({p, pDeleter});
+        if( ++rec.m_nRetired % CollectEach == 0 ){
+            TryAdvance();
+            Collect(rec);
+        }
+    }
+
+    uint64_t GetEpoch() const { return m_globalEpoch.load(std::memory_order_relaxed); }
+
+private:
+    Record &Self(){
+        thread_local ThreadHandle handle;
+        if( !handle.m_pRecord ){
+            for(auto &record : m_records){
+                bool expected = false;
+                if( !record.m_used.load(std::memory_order_relaxed) &&
+                    record.m_used.compare_exchange_strong(expected, true, std::memory_order_acquire) ){
+                    handle.m_pRecord = &record;
+                    break;
+                }
+            }
+            if( !handle.m_pRecord )
+                std::terminate();       // mas de MaxThreads hilos simultaneos
+        }
+        return *handle.m_pRecord;
+    }
+
+    // La epoca avanza solo si todos los hilos fijados ya vieron la actual
+    void TryAdvance(){
+        uint64_t epoch = m_globalEpoch.load();
+        for(auto &record : m_records){
+            uint64_t local = record.m_epoch.load();
+            if( local != kIdle && local != epoch )
+                return;
+        }
+        m_globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+    void Collect(Record &rec){
+        uint64_t epoch = m_globalEpoch.load();
+        for(unsigned b = 0; b < 3; ++b)
+            if( !rec.m_limbo[b].empty() && rec.m_limboEpoch[b] + 2 <= epoch )
+                Free(rec.m_limbo[b]);
+    }
+
+    static void Free(std::vector<Retired> &bucket){
+        for(auto &retired : bucket)
+            retired.m_pDeleter(retired.m_p);
+        bucket.clear();
+    }
+};
+
+// Seccion critica RAII
+class CEpochGuard{
+    CEpochReclaimer &m_reclaimer;
+public:
+    CEpochGuard(CEpochReclaimer &reclaimer = CEpochReclaimer::Instance())
+        : m_reclaimer(reclaimer) { m_reclaimer.Pin();   }
+    ~CEpochGuard()               { m_reclaimer.Unpin(); }
+    CEpochGuard(const CEpochGuard &) = delete;
+    CEpochGuard &operator=(const CEpochGuard &) = delete;
+};
+
+#endif // __EPOCH_H__
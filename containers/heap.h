@@ -2,13 +2,555 @@
 #define __HEAP_H__
 
 #include <iostream>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "../general/types.h"
 #include "../util.h"
+#include "treetraits.h"
+#include "nodepool.h"
+using namespace std;
 
-class CHeap{
-    // ...
-    
+// Detecta iteradores que exponen GetRef() (CArray, listas, ...)
+template <typename Iterator, typename = void>
+struct HasGetRef : std::false_type{};
+template <typename Iterator>
+struct HasGetRef<Iterator, std::void_t<decltype(std::declval<Iterator &>().GetRef())> > : std::true_type{};
+
+// Heap d-ario sobre un arreglo contiguo.
+//  - Mismos Traits que CBinaryTree (value_type, CompareFunc): un hijo sube
+//    por encima de su padre cuando comp(padre, hijo). Con TreeTraitAscending
+//    (std::greater) Top() es el minimo; con TreeTraitDescending, el maximo.
+//  - D hijos por nodo (default 4): el arbol es log2(D) veces mas bajo y los
+//    D hijos de un nodo caen en la misma linea de cache.
+//  - Los valores solo se mueven: admite tipos move-only.
+template <typename Traits, size_t D = 4>
+class CHeap {
+    static_assert(D >= 2, "CHeap: D >= 2");
+public:
+    using  value_type  = typename Traits::value_type;
+    using  CompareFunc = typename Traits::CompareFunc;
+    struct Node{
+        value_type m_value;
+        ref_type   m_ref;
+    };
+private:
+    std::vector<Node> m_heap;
+    CompareFunc       comp;
+public:
+    CHeap(){}
+    CHeap(const CHeap &another) = default;
+    CHeap(CHeap &&another) noexcept = default;
+    CHeap &operator=(const CHeap &another) = default;
+    CHeap &operator=(CHeap &&another) noexcept = default;
+    virtual ~CHeap(){}
+
+    void Push(const value_type &val, ref_type ref = -1){ Emplace(value_type(val), ref); }
+    void Push(value_type &&val,      ref_type ref = -1){ Emplace(std::move(val), ref);  }
+    const value_type &Top()    const { return m_heap.front().m_value; }
+    ref_type          TopRef() const { return m_heap.front().m_ref;   }
+    // Saca y devuelve el tope (precondicion: no vacio)
+    value_type        Pop(){
+        ref_type ref;
+        return Pop(ref);
+    }
+    value_type        Pop(ref_type &ref);
+    // Push seguido de Pop en un solo hundimiento: si 'val' seria el nuevo
+    // tope se devuelve sin tocar el heap
+    value_type        PushPop(value_type val, ref_type ref = -1){
+        ref_type out;
+        return PushPop(std::move(val), ref, out);
+    }
+    value_type        PushPop(value_type val, ref_type ref, ref_type &outRef);
+    // Reemplaza el tope (Pop + Push con un solo hundimiento)
+    void              ReplaceTop(value_type val, ref_type ref = -1){
+        m_heap.front() = Node{std::move(val), ref};
+        SiftDown(0);
+    }
+
+    // Construccion de Floyd en O(n); agrega a lo que ya hubiera
+    template <typename Iterator>
+    void Heapify(Iterator begin, Iterator end);
+    template <typename Container>
+    void Heapify(Container &container){ Heapify(container.begin(), container.end()); }
+
+    // Borra todos los que cumplen pred(value, ref) y reconstruye: O(n)
+    template <typename Pred>
+    size_t EraseIf(Pred pred);
+
+    size_t getSize() const { return m_heap.size();  }
+    bool   empty()   const { return m_heap.empty(); }
+    void   reserve(size_t n){ m_heap.reserve(n);     }
+    void   Clear()          { m_heap.clear();        }
+
+    // Recorrido en orden de arreglo (no ordenado)
+    template <typename Func2, typename... Args>
+    void Foreach(Func2 fn, Args... args){
+        for(auto &node : m_heap)
+            fn(node.m_value, args...);
+    }
+    // Idem, con la ref: fn(value, ref)
+    template <typename Func2>
+    void ForeachNode(Func2 fn) const{
+        for(auto &node : m_heap)
+            fn(node.m_value, node.m_ref);
+    }
+private:
+    void Emplace(value_type &&val, ref_type ref){
+        m_heap.push_back(Node{std::move(val), ref});
+        SiftUp(m_heap.size() - 1);
+    }
+    // Tecnica del hueco: se mueve cada nodo una sola vez
+    void SiftUp(size_t i){
+        Node node = std::move(m_heap[i]);
+        while( i > 0 ){
+            size_t parent = (i - 1) / D;
+            if( !comp(m_heap[parent].m_value, node.m_value) )
+                break;
+            m_heap[i] = std::move(m_heap[parent]);
+            i = parent;
+        }
+        m_heap[i] = std::move(node);
+    }
+    void SiftDown(size_t i){
+        size_t n    = m_heap.size();
+        Node   node = std::move(m_heap[i]);
+        while( true ){
+            size_t first = D * i + 1;
+            if( first >= n )
+                break;
+            size_t last = first + D < n ? first + D : n;
+            size_t best = first;
+            for(size_t c = first + 1; c < last; ++c)
+                best = comp(m_heap[best].m_value, m_heap[c].m_value) ? c : best;   // cmov
+            if( !comp(node.m_value, m_heap[best].m_value) )
+                break;
+            m_heap[i] = std::move(m_heap[best]);
+            i = best;
+        }
+        m_heap[i] = std::move(node);
+    }
+    void Build(){
+        if( m_heap.size() < 2 )
+            return;
+        for(size_t i = (m_heap.size() - 2) / D + 1; i-- > 0; )
+            SiftDown(i);
+    }
+
+    friend ostream &operator<<(ostream &os, CHeap<Traits, D> &container){
+        os << "CHeap: size = " << container.getSize() << endl;
+        os << "[";
+        for(auto &node : container.m_heap)
+            os << "(" << node.m_value << ":" << node.m_ref << "),";
+        os << "]" << endl;
+        return os;
+    }
 };
 
+template <typename Traits, size_t D>
+typename CHeap<Traits, D>::value_type CHeap<Traits, D>::Pop(ref_type &ref){
+    Node top = std::move(m_heap.front());
+    Node last = std::move(m_heap.back());
+    m_heap.pop_back();
+    if( !m_heap.empty() ){
+        m_heap.front() = std::move(last);
+        SiftDown(0);
+    }
+    ref = top.m_ref;
+    return std::move(top.m_value);
+}
+
+template <typename Traits, size_t D>
+typename CHeap<Traits, D>::value_type
+CHeap<Traits, D>::PushPop(value_type val, ref_type ref, ref_type &outRef){
+    if( m_heap.empty() || !comp(val, m_heap.front().m_value) ){
+        outRef = ref;
+        return val;
+    }
+    Node top = std::move(m_heap.front());
+    m_heap.front() = Node{std::move(val), ref};
+    SiftDown(0);
+    outRef = top.m_ref;
+    return std::move(top.m_value);
+}
+
+template <typename Traits, size_t D>
+template <typename Iterator>
+void CHeap<Traits, D>::Heapify(Iterator begin, Iterator end){
+    for(auto iter = begin; iter != end; ++iter){
+        if constexpr( HasGetRef<Iterator>::value )
+            m_heap.push_back(Node{*iter, iter.GetRef()});
+        else
+            m_heap.push_back(Node{*iter, -1});
+    }
+    Build();
+}
+
+template <typename Traits, size_t D>
+template <typename Pred>
+size_t CHeap<Traits, D>::EraseIf(Pred pred){
+    size_t kept = 0;
+    for(size_t i = 0; i < m_heap.size(); ++i)
+        if( !pred(m_heap[i].m_value, m_heap[i].m_ref) ){
+            if( kept != i )
+                m_heap[kept] = std::move(m_heap[i]);
+            ++kept;
+        }
+    size_t erased = m_heap.size() - kept;
+    if( erased ){
+        m_heap.erase(m_heap.begin() + kept, m_heap.end());
+        Build();
+    }
+    return erased;
+}
+
+// Cola de prioridad indexada: cada entrada se identifica por su ref_type
+// (0 <= ref < limite) y a lo sumo aparece una vez.
+//  - m_pos[ref] = posicion en el heap (o npos): Contains es O(1) y
+//    DecreaseKey/IncreaseKey/Erase ubican la entrada sin buscarla.
+//  - Mismo orden que CHeap: "Decrease" = la entrada sube hacia el tope.
+template <typename Traits, size_t D = 4>
+class CIndexedHeap {
+    static_assert(D >= 2, "CIndexedHeap: D >= 2");
+public:
+    using  value_type  = typename Traits::value_type;
+    using  CompareFunc = typename Traits::CompareFunc;
+    using  Node        = typename CHeap<Traits, D>::Node;
+    static constexpr size_t npos = size_t(-1);
+private:
+    std::vector<Node>   m_heap;
+    std::vector<size_t> m_pos;          // indexado por ref
+    CompareFunc         comp;
+public:
+    // maxRef: reserva el mapa de posiciones (crece solo si hace falta)
+    explicit CIndexedHeap(size_t maxRef = 0) : m_pos(maxRef, npos){}
+    virtual ~CIndexedHeap(){}
+
+    bool Contains(ref_type ref) const
+    { return size_t(ref) < m_pos.size() && m_pos[ref] != npos; }
+    // Precondicion: !Contains(ref)
+    void Push(const value_type &val, ref_type ref){
+        if( size_t(ref) >= m_pos.size() )
+            m_pos.resize(2 * size_t(ref) + 1, npos);
+        m_heap.push_back(Node{val, ref});
+        m_pos[ref] = m_heap.size() - 1;
+        SiftUp(m_heap.size() - 1);
+    }
+    // Inserta o cambia la prioridad de 'ref'
+    void PushOrUpdate(const value_type &val, ref_type ref){
+        if( Contains(ref) )
+            Update(ref, val);
+        else
+            Push(val, ref);
+    }
+    // La entrada mejora (sube); devuelve false si 'val' no es mejor o si
+    // 'ref' no esta en el heap
+    bool DecreaseKey(ref_type ref, const value_type &val){
+        if( !Contains(ref) )
+            return false;
+        size_t i = m_pos[ref];
+        if( !comp(m_heap[i].m_value, val) )
+            return false;
+        m_heap[i].m_value = val;
+        SiftUp(i);
+        return true;
+    }
+    // La entrada empeora (baja); devuelve false si 'val' no es peor o si
+    // 'ref' no esta en el heap
+    bool IncreaseKey(ref_type ref, const value_type &val){
+        if( !Contains(ref) )
+            return false;
+        size_t i = m_pos[ref];
+        if( !comp(val, m_heap[i].m_value) )
+            return false;
+        m_heap[i].m_value = val;
+        SiftDown(i);
+        return true;
+    }
+    // Cambia la prioridad de 'ref'; false si 'ref' no esta en el heap
+    bool Update(ref_type ref, const value_type &val){
+        if( !Contains(ref) )
+            return false;
+        if( !DecreaseKey(ref, val) )
+            IncreaseKey(ref, val);
+        return true;
+    }
+    // Precondicion: Contains(ref)
+    const value_type &GetValue(ref_type ref) const { return m_heap[m_pos[ref]].m_value; }
+
+    const value_type &Top()    const { return m_heap.front().m_value; }
+    ref_type          TopRef() const { return m_heap.front().m_ref;   }
+    value_type        Pop(){
+        ref_type ref;
+        return Pop(ref);
+    }
+    value_type        Pop(ref_type &ref){
+        ref = m_heap.front().m_ref;
+        value_type top = std::move(m_heap.front().m_value);
+        RemoveAt(0);
+        return top;
+    }
+    bool Erase(ref_type ref){
+        if( !Contains(ref) )
+            return false;
+        RemoveAt(m_pos[ref]);
+        return true;
+    }
+
+    size_t getSize() const { return m_heap.size();  }
+    bool   empty()   const { return m_heap.empty(); }
+    void   Clear(){
+        for(auto &node : m_heap)
+            m_pos[node.m_ref] = npos;
+        m_heap.clear();
+    }
+private:
+    void Place(size_t i, Node &&node){
+        m_pos[node.m_ref] = i;
+        m_heap[i] = std::move(node);
+    }
+    // Quita la posicion i rellenando con el ultimo. En i == 0 siempre se
+    // hunde: Pop ya movio el valor del tope y no se puede comparar contra el
+    void RemoveAt(size_t i){
+        m_pos[m_heap[i].m_ref] = npos;
+        Node last = std::move(m_heap.back());
+        m_heap.pop_back();
+        if( i == m_heap.size() )
+            return;
+        bool up = i > 0 && comp(m_heap[i].m_value, last.m_value);
+        Place(i, std::move(last));
+        if( up )
+            SiftUp(i);
+        else
+            SiftDown(i);
+    }
+    void SiftUp(size_t i){
+        Node node = std::move(m_heap[i]);
+        while( i > 0 ){
+            size_t parent = (i - 1) / D;
+            if( !comp(m_heap[parent].m_value, node.m_value) )
+                break;
+            Place(i, std::move(m_heap[parent]));
+            i = parent;
+        }
+        Place(i, std::move(node));
+    }
+    void SiftDown(size_t i){
+        size_t n    = m_heap.size();
+        Node   node = std::move(m_heap[i]);
+        while( true ){
+            size_t first = D * i + 1;
+            if( first >= n )
+                break;
+            size_t last = first + D < n ? first + D : n;
+            size_t best = first;
+            for(size_t c = first + 1; c < last; ++c)
+                best = comp(m_heap[best].m_value, m_heap[c].m_value) ? c : best;   // cmov
+            if( !comp(node.m_value, m_heap[best].m_value) )
+                break;
+            Place(i, std::move(m_heap[best]));
+            i = best;
+        }
+        Place(i, std::move(node));
+    }
+
+    friend ostream &operator<<(ostream &os, CIndexedHeap<Traits, D> &container){
+        os << "CIndexedHeap: size = " << container.getSize() << endl;
+        os << "[";
+        for(auto &node : container.m_heap)
+            os << "(" << node.m_value << ":" << node.m_ref << "),";
+        os << "]" << endl;
+        return os;
+    }
+};
+
+// Pairing heap (mergeable): mismo orden que CHeap.
+//  - Push y Meld O(1): solo enlazan raices (Meld adopta ademas los chunks
+//    del pool del otro heap, O(chunks)).
+//  - Pop O(log n) amortizado (emparejamiento en dos pasadas).
+//  - Push devuelve un handle estable para DecreaseKey / Erase.
+//  - Los nodos salen de _Alloc (CNodePool por defecto): destruir el heap
+//    libera la memoria en O(chunks).
+template <typename Traits>
+struct NodePairingHeap{
+    using  value_type  = typename Traits::value_type;
+    using  Node        = NodePairingHeap<Traits>;
+
+    value_type m_value;
+    ref_type   m_ref;
+    Node      *m_pChild   = nullptr;    // primer hijo
+    Node      *m_pSibling = nullptr;    // siguiente hermano
+    Node      *m_pPrev    = nullptr;    // hermano anterior, o el padre si es el primer hijo
+
+    NodePairingHeap(const value_type &_value, ref_type _ref)
+        : m_value(_value), m_ref(_ref){}
+    NodePairingHeap(value_type &&_value, ref_type _ref)
+        : m_value(std::move(_value)), m_ref(_ref){}
+};
+
+template <typename Traits, template <typename> class _Alloc = CNodePool>
+class CPairingHeap {
+public:
+    using  value_type  = typename Traits::value_type;
+    using  CompareFunc = typename Traits::CompareFunc;
+    using  Node        = NodePairingHeap<Traits>;
+    using  Allocator   = _Alloc<Node>;
+    using  handle      = Node *;
+private:
+    Node              *m_pRoot     = nullptr;
+    size_t             m_nElements = 0;
+    Allocator          m_alloc;
+    std::vector<Node *> m_scratch;          // reutilizado por Pop: sin asignar
+    CompareFunc        comp;
+public:
+    CPairingHeap(){}
+    CPairingHeap(const CPairingHeap &) = delete;
+    CPairingHeap &operator=(const CPairingHeap &) = delete;
+    CPairingHeap(CPairingHeap &&another) noexcept
+        : m_pRoot    (std::exchange(another.m_pRoot, nullptr)),
+          m_nElements(std::exchange(another.m_nElements, 0)),
+          m_alloc    (std::move(another.m_alloc)){}
+    virtual ~CPairingHeap(){ Clear(); }
+
+    handle Push(const value_type &val, ref_type ref = -1){ return Insert(m_alloc.New(val, ref));            }
+    handle Push(value_type &&val,      ref_type ref = -1){ return Insert(m_alloc.New(std::move(val), ref)); }
+    const value_type &Top()    const { return m_pRoot->m_value; }
+    ref_type          TopRef() const { return m_pRoot->m_ref;   }
+    value_type        Pop(){
+        ref_type ref;
+        return Pop(ref);
+    }
+    value_type        Pop(ref_type &ref);
+
+    // Precondicion: 'val' no es peor que el valor actual del handle
+    void   DecreaseKey(handle h, const value_type &val);
+    void   Erase(handle h);
+    // Mueve todos los nodos de 'another' a este heap: O(1) en elementos
+    void   Meld(CPairingHeap &&another);
+
+    const value_type &GetValue(handle h) const { return h->m_value; }
+    ref_type          GetRef  (handle h) const { return h->m_ref;   }
+    size_t getSize() const { return m_nElements;     }
+    bool   empty()   const { return m_pRoot == nullptr; }
+    void   Clear();
+private:
+    handle Insert(Node *pNode){
+        m_pRoot = m_pRoot ? Link(m_pRoot, pNode) : pNode;
+        ++m_nElements;
+        return pNode;
+    }
+    // El perdedor pasa a ser el primer hijo del ganador
+    Node *Link(Node *a, Node *b){
+        if( comp(a->m_value, b->m_value) )
+            std::swap(a, b);
+        b->m_pPrev    = a;
+        b->m_pSibling = a->m_pChild;
+        if( a->m_pChild )
+            a->m_pChild->m_pPrev = b;
+        a->m_pChild   = b;
+        a->m_pSibling = a->m_pPrev = nullptr;
+        return a;
+    }
+    // Desengancha el subarbol de pNode (pNode no es la raiz)
+    void Cut(Node *pNode){
+        if( pNode->m_pPrev->m_pChild == pNode )
+            pNode->m_pPrev->m_pChild = pNode->m_pSibling;
+        else
+            pNode->m_pPrev->m_pSibling = pNode->m_pSibling;
+        if( pNode->m_pSibling )
+            pNode->m_pSibling->m_pPrev = pNode->m_pPrev;
+        pNode->m_pSibling = pNode->m_pPrev = nullptr;
+    }
+    // Dos pasadas: se emparejan de izquierda a derecha y se acumulan de
+    // derecha a izquierda
+    Node *CombineChildren(Node *pFirst);
+};
+
+template <typename Traits, template <typename> class _Alloc>
+typename CPairingHeap<Traits, _Alloc>::Node *
+CPairingHeap<Traits, _Alloc>::CombineChildren(Node *pFirst){
+    if( !pFirst )
+        return nullptr;
+    m_scratch.clear();
+    while( pFirst ){
+        Node *a = pFirst, *b = a->m_pSibling;
+        if( !b ){
+            a->m_pPrev = nullptr;
+            m_scratch.push_back(a);
+            break;
+        }
+        pFirst = b->m_pSibling;
+        a->m_pSibling = b->m_pSibling = a->m_pPrev = b->m_pPrev = nullptr;
+        m_scratch.push_back(Link(a, b));
+    }
+    Node *pRoot = m_scratch.back();
+    for(size_t i = m_scratch.size() - 1; i-- > 0; )
+        pRoot = Link(m_scratch[i], pRoot);
+    return pRoot;
+}
+
+template <typename Traits, template <typename> class _Alloc>
+typename CPairingHeap<Traits, _Alloc>::value_type CPairingHeap<Traits, _Alloc>::Pop(ref_type &ref){
+    Node *pTop = m_pRoot;
+    m_pRoot = CombineChildren(pTop->m_pChild);
+    --m_nElements;
+    ref = pTop->m_ref;
+    value_type top = std::move(pTop->m_value);
+    m_alloc.Delete(pTop);
+    return top;
+}
+
+template <typename Traits, template <typename> class _Alloc>
+void CPairingHeap<Traits, _Alloc>::DecreaseKey(handle h, const value_type &val){
+    h->m_value = val;
+    if( h == m_pRoot )
+        return;
+    Cut(h);
+    m_pRoot = Link(m_pRoot, h);
+}
+
+template <typename Traits, template <typename> class _Alloc>
+void CPairingHeap<Traits, _Alloc>::Erase(handle h){
+    if( h == m_pRoot ){
+        Pop();
+        return;
+    }
+    Cut(h);
+    Node *pSub = CombineChildren(h->m_pChild);
+    if( pSub )
+        m_pRoot = Link(m_pRoot, pSub);
+    --m_nElements;
+    m_alloc.Delete(h);
+}
+
+template <typename Traits, template <typename> class _Alloc>
+void CPairingHeap<Traits, _Alloc>::Meld(CPairingHeap &&another){
+    if( this == &another || !another.m_pRoot )
+        return;
+    m_alloc.Absorb(std::move(another.m_alloc));
+    m_pRoot = m_pRoot ? Link(m_pRoot, another.m_pRoot) : another.m_pRoot;
+    m_nElements += std::exchange(another.m_nElements, 0);
+    another.m_pRoot = nullptr;
+}
+
+template <typename Traits, template <typename> class _Alloc>
+void CPairingHeap<Traits, _Alloc>::Clear(){
+    if constexpr( CanBulkRelease<Allocator, Node>() )
+        m_alloc.Release();
+    else if( m_pRoot ){
+        // Recorrido iterativo: la profundidad puede ser O(n)
+        m_scratch.assign(1, m_pRoot);
+        while( !m_scratch.empty() ){
+            Node *pNode = m_scratch.back();
+            m_scratch.pop_back();
+            for(Node *pChild = pNode->m_pChild; pChild; pChild = pChild->m_pSibling)
+                m_scratch.push_back(pChild);
+            m_alloc.Delete(pNode);
+        }
+    }
+    m_pRoot     = nullptr;
+    m_nElements = 0;
+}
 
-#endif // __HEAP_H__
\ No newline at end of file
+#endif // __HEAP_H__
@@ -1,28 +1,75 @@
 #ifndef __LINKEDLIST_H__
 #define __LINKEDLIST_H__
 #include <iostream>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <algorithm>
+#include <utility>
+#include <vector>
 #include "../general/types.h"
 #include "../util.h"
+#include "nodepool.h"
 using namespace std;
 
-// TODO: Traits para listas enlazadas
-template <typename T, typename _Func>
+// Traits para listas enlazadas
+// _Alloc decide de donde salen los nodos (new/delete o pool por bloques)
+template <typename T, typename _Func, template <typename> class _Alloc = CNewAllocator>
 struct ListTrait{
     using value_type = T;
     using Func       = _Func;
+    template <typename Node>
+    using Allocator  = _Alloc<Node>;
 };
 
 template <typename T>
-struct AscendingTrait : 
+struct AscendingTrait :
     public ListTrait<T, std::greater<T> >{
 };
 
 template <typename T>
-struct DescendingTrait : 
+struct DescendingTrait :
     public ListTrait<T, std::less<T> >{
 };
 
+template <typename T>
+struct AscendingPoolTrait :
+    public ListTrait<T, std::greater<T>, CNodePool >{
+};
+
+template <typename T>
+struct DescendingPoolTrait :
+    public ListTrait<T, std::less<T>, CNodePool >{
+};
+
 // Iterators para listas enlazadas
+template <typename Container>
+class LinkedListForwardIterator{
+public:
+    using value_type = typename Container::value_type;
+private:
+    using Node       = typename Container::Node;
+    using Iterator   = LinkedListForwardIterator<Container>;
+private:
+    Node *m_pCurrent = nullptr;
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = ptrdiff_t;
+    using pointer           = value_type *;
+    using reference         = value_type &;
+
+    LinkedListForwardIterator(Node *pCurrent)
+        : m_pCurrent(pCurrent){}
+    value_type &operator*()                        { return m_pCurrent->GetValueRef(); }
+    ref_type    GetRef() const                     { return m_pCurrent->GetRef();      }
+    bool operator!=(const Iterator &another) const { return m_pCurrent != another.m_pCurrent; }
+    bool operator==(const Iterator &another) const { return m_pCurrent == another.m_pCurrent; }
+    Iterator &operator++(){
+        m_pCurrent = m_pCurrent->GetNext();
+        return *this;
+    }
+};
 
 template <typename Traits>
 class NodeLinkedList{
@@ -36,8 +83,8 @@ private:
 
 public:
     NodeLinkedList(){}
-    NodeLinkedList( value_type _value, ref_type _ref = -1)
-        : m_data(_value), m_ref(_ref){   }
+    NodeLinkedList( value_type _value, ref_type _ref = -1, Node *pNext = nullptr)
+        : m_data(_value), m_ref(_ref), m_pNext(pNext){   }
     value_type  GetValue   () const { return m_data; }
     value_type &GetValueRef() { return m_data; }
 
@@ -60,67 +107,259 @@ public:
 
 template <typename Traits>
 class CLinkedList {
+public:
     using  value_type  = typename Traits::value_type;
-    // using  forward_iterator  = LinkedListForwardIterator < CLinkedList<Traits> >;
-    // friend forward_iterator;
-    // friend GeneralIterator< CLinkedList<Traits> >;
-    using  Node = NodeLinkedList<Traits>;
-
+    using  Node        = NodeLinkedList<Traits>;
+    using  Func        = typename Traits::Func;
+    using  Allocator   = typename Traits::template Allocator<Node>;
+    using  forward_iterator  = LinkedListForwardIterator < CLinkedList<Traits> >;
+private:
     Node *m_pRoot = nullptr;
     Node *m_pLast = nullptr;
     size_t m_nElements = 0;
+    Allocator m_alloc;
 public:
     CLinkedList(){}
-    // TODO: Constructor copia
-    // TODO: Move Constructor
-    // TODO: Destructor seguro y virtual
-    // TODO: Concurrencia (mutex)
-    // TODO: Iterators begin() end()
+    CLinkedList(const CLinkedList &another);
+    CLinkedList(CLinkedList &&another) noexcept;
+    virtual ~CLinkedList(){ Clear(); }
+    // Concurrencia: ver CConcurrentLinkedList (concurrentlist.h)
     // TODO: Operadores de acceso []
 
-    void push_back(value_type &val, ref_type ref);
+    void push_back(const value_type &val, ref_type ref);
     void Insert(const value_type &val, ref_type ref);
+    void Clear();
+
+    // Inserta m elementos en un solo recorrido: O(m log m + n)
+    template <typename Iterator>
+    void InsertBatch(Iterator begin, Iterator end);
+    template <typename Container>
+    void InsertBatch(Container &container){ InsertBatch(container.begin(), container.end()); }
+    // Mezcla dos listas ordenadas reenlazando nodos (sin asignar): O(n + m)
+    void Merge(CLinkedList &&another);
+
+    // Persistencia binaria: pares (value, ref) en el orden de la lista.
+    // Read reemplaza el contenido; si el archivo no es valido o esta
+    // truncado devuelve false y la lista queda vacia (nunca a medias).
+    void Write(ostream &os);
+    bool Read (istream &is);
     size_t getSize(){ return m_nElements;  }
+
+    forward_iterator begin() { return forward_iterator(m_pRoot);  }
+    forward_iterator end()   { return forward_iterator(nullptr);  }
 private:
     void InternalInsert(Node *&rParent, const value_type &val, ref_type ref);
 
-    // TODO: Persistencia (write)
+    static constexpr uint32_t FileMagic  = 0x314C4C43;     // "CLL1"
+    static constexpr size_t   RecordSize = sizeof(value_type) + sizeof(ref_type);
+    static constexpr size_t   BufferRecords = 4096;
+
     friend ostream &operator<<(ostream &os, CLinkedList<Traits> &container){
         os << "CLinkedList: size = " << container.getSize() << endl;
         os << "[";
-        for (auto i = 0; i < container.getSize(); ++i){
-            // os << "(" << arr.m_data[i].GetValue() << ":" << arr.m_data[i].GetRef() << "),";
-        }
+        for (Node *pNode = container.m_pRoot; pNode; pNode = pNode->GetNext())
+            os << "(" << pNode->GetValue() << ":" << pNode->GetRef() << "),";
         os << "]" << endl;
         return os;
     }
-    // TODO: Persistencia (read)
+    // Texto: n y luego n pares "value ref" (mismo formato que CBinaryTree)
+    friend istream &operator>>(istream &is, CLinkedList<Traits> &container){
+        size_t nElements = 0;
+        is >> nElements;
+        for (size_t i = 0; i < nElements && is; ++i){
+            value_type val;
+            ref_type   ref;
+            if( is >> val >> ref )
+                container.Insert(val, ref);
+        }
+        return is;
+    }
 };
 
 template <typename Traits>
-void CLinkedList<Traits>::push_back(value_type &val, ref_type ref){
-    Node *pNewNode = new Node(val, ref);
+CLinkedList<Traits>::CLinkedList(const CLinkedList &another){
+    for(Node *pNode = another.m_pRoot; pNode; pNode = pNode->GetNext())
+        push_back(pNode->GetValue(), pNode->GetRef());
+}
+
+template <typename Traits>
+CLinkedList<Traits>::CLinkedList(CLinkedList &&another) noexcept
+    : m_pRoot    (std::exchange(another.m_pRoot, nullptr)),
+      m_pLast    (std::exchange(another.m_pLast, nullptr)),
+      m_nElements(std::exchange(another.m_nElements, 0)),
+      m_alloc    (std::move(another.m_alloc)){
+}
+
+// Con pool y nodos triviales se liberan los chunks: O(chunks)
+template <typename Traits>
+void CLinkedList<Traits>::Clear(){
+    if constexpr( CanBulkRelease<Allocator, Node>() )
+        m_alloc.Release();
+    else{
+        while( m_pRoot ){
+            Node *pNext = m_pRoot->GetNext();
+            m_alloc.Delete(m_pRoot);
+            m_pRoot = pNext;
+        }
+    }
+    m_pRoot = m_pLast = nullptr;
+    m_nElements = 0;
+}
+
+template <typename Traits>
+void CLinkedList<Traits>::push_back(const value_type &val, ref_type ref){
+    Node *pNewNode = m_alloc.New(val, ref);
     if( !m_pRoot )
         m_pRoot = pNewNode;
+    else
+        m_pLast->GetNextRef() = pNewNode;
     m_pLast = pNewNode;
     ++m_nElements;
 }
 
+// Iterativo (puntero al enlace): no crece la pila en listas largas
 template <typename Traits>
 void CLinkedList<Traits>::InternalInsert(Node *&rParent, const value_type &val, ref_type ref){
     // TODO: Agregar algo para el caso de circular
-    if( !rParent || rParent->m_data > val ){
-        Node *pNew = new Node(val, ref, rParent);
-        rParent = pNew;
+    Node **ppLink = &rParent;
+    while( *ppLink && !Func()((*ppLink)->GetValue(), val) )
+        ppLink = &(*ppLink)->GetNextRef();
+    Node *pNew = m_alloc.New(val, ref, *ppLink);
+    if( !*ppLink )
+        m_pLast = pNew;
+    *ppLink = pNew;
+    ++m_nElements;
+}
+
+// Si 'val' va al final (entrada ya ordenada) se agrega en O(1)
+template <typename Traits>
+void CLinkedList<Traits>::Insert(const value_type &val, ref_type ref){
+    if( m_pLast && !Func()(m_pLast->GetValue(), val) ){
+        m_pLast->GetNextRef() = m_alloc.New(val, ref);
+        m_pLast = m_pLast->GetNext();
         ++m_nElements;
         return;
     }
-    InternalInsert(rParent->GetNextRef(), val, ref);
+    InternalInsert(m_pRoot, val, ref);
 }
 
+// El lote puede traer valores sueltos (ref = -1) o pares (value, ref)
 template <typename Traits>
-void CLinkedList<Traits>::Insert(const value_type &val, ref_type ref){
-    InternalInsert(m_pRoot, val, ref);
+template <typename Iterator>
+void CLinkedList<Traits>::InsertBatch(Iterator begin, Iterator end){
+    std::vector< std::pair<value_type, ref_type> > batch;
+    for(auto iter = begin; iter != end; ++iter){
+        if constexpr( std::is_convertible<decltype(*iter), value_type>::value )
+            batch.emplace_back(*iter, -1);
+        else
+            batch.emplace_back((*iter).first, (*iter).second);
+    }
+    Func comp;
+    std::stable_sort(batch.begin(), batch.end(), [&comp](const auto &a, const auto &b){
+        return comp(b.first, a.first);
+    });
+    // Merge lineal: el enlace solo avanza, nunca vuelve a la cabeza
+    Node **ppLink = &m_pRoot;
+    for(auto &elem : batch){
+        while( *ppLink && !comp((*ppLink)->GetValue(), elem.first) )
+            ppLink = &(*ppLink)->GetNextRef();
+        Node *pNew = m_alloc.New(elem.first, elem.second, *ppLink);
+        if( !*ppLink )
+            m_pLast = pNew;
+        *ppLink = pNew;
+        ppLink  = &pNew->GetNextRef();
+        ++m_nElements;
+    }
+}
+
+// Ante empates quedan primero los de esta lista (merge estable)
+template <typename Traits>
+void CLinkedList<Traits>::Merge(CLinkedList &&another){
+    if( this == &another || !another.m_pRoot )
+        return;
+    m_alloc.Absorb(std::move(another.m_alloc));
+    Func  comp;
+    Node *pOther = std::exchange(another.m_pRoot, nullptr);
+    Node **ppLink = &m_pRoot;
+    while( pOther ){
+        while( *ppLink && !comp((*ppLink)->GetValue(), pOther->GetValue()) )
+            ppLink = &(*ppLink)->GetNextRef();
+        if( !*ppLink ){                 // el resto de 'another' va al final
+            *ppLink = pOther;
+            m_pLast = another.m_pLast;
+            break;
+        }
+        // Tramo de 'another' que va antes de *ppLink
+        Node *pFirst = pOther, *pLastRun = pOther;
+        while( pLastRun->GetNext() && comp((*ppLink)->GetValue(), pLastRun->GetNext()->GetValue()) )
+            pLastRun = pLastRun->GetNext();
+        pOther = pLastRun->GetNext();
+        pLastRun->GetNextRef() = *ppLink;
+        *ppLink = pFirst;
+        ppLink  = &pLastRun->GetNextRef();
+    }
+    m_nElements += std::exchange(another.m_nElements, 0);
+    another.m_pLast = nullptr;
+}
+
+// Cabecera: magic, tamano de registro, cantidad. Se escribe por bloques.
+template <typename Traits>
+void CLinkedList<Traits>::Write(ostream &os){
+    static_assert(std::is_trivially_copyable<value_type>::value,
+                  "Write/Read requieren un value_type trivialmente copiable");
+    uint32_t header[2] = { FileMagic, static_cast<uint32_t>(RecordSize) };
+    uint64_t count     = m_nElements;
+    os.write(reinterpret_cast<const char *>(header), sizeof(header));
+    os.write(reinterpret_cast<const char *>(&count), sizeof(count));
+
+    std::vector<char> buffer(BufferRecords * RecordSize);
+    size_t used = 0;
+    for(Node *pNode = m_pRoot; pNode; pNode = pNode->GetNext()){
+        value_type val = pNode->GetValue();
+        ref_type   ref = pNode->GetRef();
+        std::memcpy(&buffer[used],                      &val, sizeof(val));
+        std::memcpy(&buffer[used + sizeof(value_type)], &ref, sizeof(ref));
+        used += RecordSize;
+        if( used == buffer.size() ){
+            os.write(buffer.data(), used);
+            used = 0;
+        }
+    }
+    os.write(buffer.data(), used);
+}
+
+// Los pares llegan en orden de la lista: cada Insert cae en la cola (O(1)),
+// asi que recargar n elementos es O(n). Si el archivo no esta ordenado
+// igual funciona, cayendo al Insert ordenado para los que no van al final.
+template <typename Traits>
+bool CLinkedList<Traits>::Read(istream &is){
+    static_assert(std::is_trivially_copyable<value_type>::value,
+                  "Write/Read requieren un value_type trivialmente copiable");
+    Clear();
+    uint32_t header[2];
+    uint64_t count;
+    if( !is.read(reinterpret_cast<char *>(header), sizeof(header)) ||
+        header[0] != FileMagic || header[1] != RecordSize ||
+        !is.read(reinterpret_cast<char *>(&count), sizeof(count)) )
+        return false;
+
+    std::vector<char> buffer(BufferRecords * RecordSize);
+    while( count ){
+        size_t nRecords = count < BufferRecords ? count : BufferRecords;
+        if( !is.read(buffer.data(), nRecords * RecordSize) ){
+            Clear();                    // truncado: no dejar una carga parcial
+            return false;
+        }
+        for(size_t i = 0; i < nRecords; ++i){
+            value_type val;
+            ref_type   ref;
+            std::memcpy(&val, &buffer[i * RecordSize],                      sizeof(val));
+            std::memcpy(&ref, &buffer[i * RecordSize + sizeof(value_type)], sizeof(ref));
+            Insert(val, ref);
+        }
+        count -= nRecords;
+    }
+    return true;
 }
 
 #endif // __LINKEDLIST_H__
@@ -3,6 +3,10 @@
 #include "../general/types.h"
 
 #include "linkedlist.h"
+#include "skiplist.h"
+#include "unrolledlist.h"
+#include "concurrentlist.h"
+#include "doublelinkedlist.h"
 
 void DemoLists();
 
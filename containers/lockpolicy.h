@@ -0,0 +1,49 @@
+#ifndef __LOCKPOLICY_H__
+#define __LOCKPOLICY_H__
+
+#include <mutex>
+#include <shared_mutex>
+
+// Politicas de bloqueo para contenedores (se eligen via Traits).
+// Todas exponen la misma interfaz:
+//   auto lock = m_lock.Read();    // lectura: Find, recorridos, operator<<
+//   auto lock = m_lock.Write();   // escritura: Insert, Remove, operator>>
+// El lock se libera al destruirse 'lock'.
+
+// Un solo recursive_mutex para todo (comportamiento historico): los
+// lectores se serializan, pero un callback puede volver a entrar al
+// contenedor desde el mismo hilo.
+class CRecursiveLock{
+    mutable std::recursive_mutex m_mtx;
+public:
+    using ReadLock  = std::unique_lock<std::recursive_mutex>;
+    using WriteLock = std::unique_lock<std::recursive_mutex>;
+    ReadLock  Read()  const { return ReadLock(m_mtx);  }
+    WriteLock Write() const { return WriteLock(m_mtx); }
+};
+
+// Lectores en paralelo (shared_lock), escritores exclusivos.
+// No es reentrante, ni siquiera para leer: un callback de Foreach (o de
+// cualquier recorrido) no debe volver a llamar al mismo contenedor, tampoco
+// a Find/Contains. Tomar dos veces el shared_lock desde un hilo es
+// comportamiento indefinido y se traba si ya hay un escritor esperando.
+class CSharedLock{
+    mutable std::shared_mutex m_mtx;
+public:
+    using ReadLock  = std::shared_lock<std::shared_mutex>;
+    using WriteLock = std::unique_lock<std::shared_mutex>;
+    ReadLock  Read()  const { return ReadLock(m_mtx);  }
+    WriteLock Write() const { return WriteLock(m_mtx); }
+};
+
+// Sin bloqueo: para uso desde un solo hilo
+class CNoLock{
+public:
+    struct Guard{ ~Guard(){} };
+    using ReadLock  = Guard;
+    using WriteLock = Guard;
+    ReadLock  Read()  const { return Guard(); }
+    WriteLock Write() const { return Guard(); }
+};
+
+#endif // __LOCKPOLICY_H__
@@ -0,0 +1,286 @@
+#ifndef __LRUCACHE_H__
+#define __LRUCACHE_H__
+
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "../general/types.h"
+#include "doublelinkedlist.h"
+
+// Cache LRU con Get/Put/Erase O(1):
+//  - Recencia: CDoubleLinkedList (Front = mas reciente, Back = victima).
+//  - Indice: hash abierto con sondeo lineal sobre handles de la lista;
+//    cada slot guarda tambien el hash (32 bits) para no comparar claves de mas
+//    y para poder borrar con desplazamiento hacia atras (sin lapidas).
+//  - Capacidad en entradas y/o en bytes (0 = sin limite en esa dimension).
+// No es thread-safe: para varios hilos ver CShardedLRUCache.
+template <typename Key = ref_type, typename Value = ref_type>
+class CLRUCache {
+public:
+    struct Entry{
+        Key    m_key   = Key();
+        Value  m_value = Value();
+        size_t m_bytes = 0;
+    };
+    using  List   = CDoubleLinkedList< ListTrait<Entry, std::greater<Entry> > >;
+    using  handle = typename List::handle;
+    static constexpr size_t DefaultBytes = sizeof(Key) + sizeof(Value);
+
+    static uint64_t Hash(const Key &key){
+        // std::hash de enteros es la identidad: se mezcla (finalizador de murmur3)
+        uint64_t h = std::hash<Key>()(key);
+        h ^= h >> 33;  h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;  h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+private:
+    struct Slot{
+        handle   m_handle = List::npos;
+        uint32_t m_hash   = 0;
+    };
+    List              m_list;
+    std::vector<Slot> m_slots;
+    size_t  m_mask     = 0;
+    size_t  m_maxEntries, m_maxBytes;
+    size_t  m_nBytes   = 0;
+    size_t  m_nHits    = 0, m_nMisses = 0, m_nEvictions = 0;
+public:
+    CLRUCache(size_t maxEntries, size_t maxBytes = 0)
+        : m_maxEntries(maxEntries), m_maxBytes(maxBytes){
+        size_t n = 16;
+        while( maxEntries && n < 2 * maxEntries )
+            n *= 2;
+        m_slots.resize(n);
+        m_mask = n - 1;
+        if( maxEntries )
+            m_list.reserve(maxEntries);
+    }
+    virtual ~CLRUCache(){}
+
+    // En un acierto la entrada pasa a ser la mas reciente
+    bool   Get(const Key &key, Value &value);
+    bool   Contains(const Key &key) const { return m_slots[FindSlot(key, uint32_t(Hash(key)))].m_handle != List::npos; }
+    // Inserta o actualiza; desaloja desde el Back hasta cumplir los limites
+    void   Put(const Key &key, const Value &value, size_t bytes = DefaultBytes);
+    bool   Erase(const Key &key);
+    void   Clear();
+
+    size_t getSize()      const { return m_list.getSize(); }
+    size_t getBytes()     const { return m_nBytes;     }
+    size_t getHits()      const { return m_nHits;      }
+    size_t getMisses()    const { return m_nMisses;    }
+    size_t getEvictions() const { return m_nEvictions; }
+    double HitRatio()     const { return m_nHits + m_nMisses ? double(m_nHits) / (m_nHits + m_nMisses) : 0; }
+
+    // Recorrido de la mas reciente a la menos reciente
+    template <typename Func2, typename... Args>
+    void Foreach(Func2 fn, Args... args){
+        for(auto &entry : m_list)
+            fn(entry.m_key, entry.m_value, args...);
+    }
+private:
+    // Slot de 'key' o el slot vacio donde iria
+    size_t FindSlot(const Key &key, uint32_t hash) const{
+        size_t i = hash & m_mask;
+        while( m_slots[i].m_handle != List::npos ){
+            if( m_slots[i].m_hash == hash &&
+                const_cast<List &>(m_list).GetValueRef(m_slots[i].m_handle).m_key == key )
+                return i;
+            i = (i + 1) & m_mask;
+        }
+        return i;
+    }
+    void   EraseSlot(size_t i);
+    void   Evict();
+    void   Grow();
+
+    friend ostream &operator<<(ostream &os, CLRUCache &container){
+        os << "CLRUCache: size = " << container.getSize() << ", bytes = " << container.getBytes()
+           << ", hits = " << container.getHits() << ", misses = " << container.getMisses() << endl;
+        os << "[";
+        container.Foreach([&os](const Key &key, const Value &value){ os << "(" << key << ":" << value << "),"; });
+        os << "]" << endl;
+        return os;
+    }
+};
+
+template <typename Key, typename Value>
+bool CLRUCache<Key, Value>::Get(const Key &key, Value &value){
+    Slot &slot = m_slots[FindSlot(key, uint32_t(Hash(key)))];
+    if( slot.m_handle == List::npos ){
+        ++m_nMisses;
+        return false;
+    }
+    ++m_nHits;
+    m_list.MoveToFront(slot.m_handle);
+    value = m_list.GetValueRef(slot.m_handle).m_value;
+    return true;
+}
+
+template <typename Key, typename Value>
+void CLRUCache<Key, Value>::Put(const Key &key, const Value &value, size_t bytes){
+    uint32_t hash = uint32_t(Hash(key));
+    size_t   i    = FindSlot(key, hash);
+    if( m_slots[i].m_handle != List::npos ){
+        Entry &entry = m_list.GetValueRef(m_slots[i].m_handle);
+        m_nBytes += bytes - entry.m_bytes;
+        entry.m_value = value;
+        entry.m_bytes = bytes;
+        m_list.MoveToFront(m_slots[i].m_handle);
+    }
+    else{
+        if( 2 * (m_list.getSize() + 1) > m_slots.size() ){
+            Grow();
+            i = FindSlot(key, hash);
+        }
+        m_slots[i] = {m_list.push_front(Entry{key, value, bytes}, -1), hash};
+        m_nBytes += bytes;
+    }
+    // Nunca se desaloja la que se acaba de poner
+    while( m_list.getSize() > 1 &&
+           ((m_maxEntries && m_list.getSize() > m_maxEntries) || (m_maxBytes && m_nBytes > m_maxBytes)) )
+        Evict();
+}
+
+template <typename Key, typename Value>
+bool CLRUCache<Key, Value>::Erase(const Key &key){
+    size_t i = FindSlot(key, uint32_t(Hash(key)));
+    handle h = m_slots[i].m_handle;
+    if( h == List::npos )
+        return false;
+    m_nBytes -= m_list.GetValueRef(h).m_bytes;
+    EraseSlot(i);
+    m_list.erase(h);
+    return true;
+}
+
+template <typename Key, typename Value>
+void CLRUCache<Key, Value>::Evict(){
+    handle h = m_list.Back();
+    Entry &entry = m_list.GetValueRef(h);
+    m_nBytes -= entry.m_bytes;
+    EraseSlot(FindSlot(entry.m_key, uint32_t(Hash(entry.m_key))));
+    m_list.erase(h);
+    ++m_nEvictions;
+}
+
+// Borrado con desplazamiento hacia atras: mueve al hueco cada slot del
+// cluster cuyo "home" no quede entre el hueco y su posicion actual
+template <typename Key, typename Value>
+void CLRUCache<Key, Value>::EraseSlot(size_t i){
+    size_t j = i;
+    while( true ){
+        j = (j + 1) & m_mask;
+        if( m_slots[j].m_handle == List::npos )
+            break;
+        size_t home = m_slots[j].m_hash & m_mask;
+        if( ((j - home) & m_mask) >= ((j - i) & m_mask) ){
+            m_slots[i] = m_slots[j];
+            i = j;
+        }
+    }
+    m_slots[i] = Slot();
+}
+
+template <typename Key, typename Value>
+void CLRUCache<Key, Value>::Grow(){
+    std::vector<Slot> old(m_slots.size() * 2);
+    old.swap(m_slots);
+    m_mask = m_slots.size() - 1;
+    for(auto &slot : old)
+        if( slot.m_handle != List::npos ){
+            size_t i = slot.m_hash & m_mask;
+            while( m_slots[i].m_handle != List::npos )
+                i = (i + 1) & m_mask;
+            m_slots[i] = slot;
+        }
+}
+
+template <typename Key, typename Value>
+void CLRUCache<Key, Value>::Clear(){
+    m_list.Clear();
+    std::fill(m_slots.begin(), m_slots.end(), Slot());
+    m_nBytes = m_nHits = m_nMisses = m_nEvictions = 0;
+}
+
+// Envoltorio thread-safe: Shards caches independientes, cada una con su
+// mutex y en su propia linea de cache. La shard sale de los bits altos del
+// hash (el indice interno usa los bajos). Los limites se reparten sin
+// redondear hacia arriba: las partes suman exactamente maxEntries/maxBytes
+// (el resto va a las primeras shards). Como una shard nunca desaloja la
+// entrada recien puesta y 0 significa sin limite, ninguna parte baja de 1:
+// con maxEntries < Shards el total puede llegar a Shards entradas.
+template <typename Key = ref_type, typename Value = ref_type, size_t Shards = 16>
+class CShardedLRUCache {
+    using  Cache = CLRUCache<Key, Value>;
+    struct alignas(64) Shard{
+        std::mutex m_mtx;
+        Cache      m_cache;
+        Shard(size_t maxEntries, size_t maxBytes) : m_cache(maxEntries, maxBytes){}
+    };
+    std::vector<Shard *> m_shards;
+public:
+    CShardedLRUCache(size_t maxEntries, size_t maxBytes = 0){
+        for(size_t s = 0; s < Shards; ++s)
+            m_shards.push_back(new Shard(Share(maxEntries, s), Share(maxBytes, s)));
+    }
+    CShardedLRUCache(const CShardedLRUCache &) = delete;
+    CShardedLRUCache &operator=(const CShardedLRUCache &) = delete;
+    virtual ~CShardedLRUCache(){
+        for(auto pShard : m_shards)
+            delete pShard;
+    }
+
+    bool Get(const Key &key, Value &value){
+        Shard &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.m_mtx);
+        return shard.m_cache.Get(key, value);
+    }
+    void Put(const Key &key, const Value &value, size_t bytes = Cache::DefaultBytes){
+        Shard &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.m_mtx);
+        shard.m_cache.Put(key, value, bytes);
+    }
+    bool Erase(const Key &key){
+        Shard &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.m_mtx);
+        return shard.m_cache.Erase(key);
+    }
+    void Clear(){ Sum([](Cache &cache){ cache.Clear(); return size_t(0); }); }
+
+    size_t getSize()      { return Sum([](Cache &cache){ return cache.getSize();      }); }
+    size_t getBytes()     { return Sum([](Cache &cache){ return cache.getBytes();     }); }
+    size_t getHits()      { return Sum([](Cache &cache){ return cache.getHits();      }); }
+    size_t getMisses()    { return Sum([](Cache &cache){ return cache.getMisses();    }); }
+    size_t getEvictions() { return Sum([](Cache &cache){ return cache.getEvictions(); }); }
+    double HitRatio(){
+        size_t hits = getHits(), total = hits + getMisses();
+        return total ? double(hits) / total : 0;
+    }
+private:
+    // Parte de 'limit' que le toca a la shard s (0 = sin limite se conserva)
+    static size_t Share(size_t limit, size_t s){
+        if( !limit )
+            return 0;
+        size_t share = limit / Shards + (s < limit % Shards ? 1 : 0);
+        return share ? share : 1;
+    }
+    Shard &GetShard(const Key &key){
+        return *m_shards[(Cache::Hash(key) >> 40) % Shards];
+    }
+    template <typename F>
+    size_t Sum(F fn){
+        size_t total = 0;
+        for(auto pShard : m_shards){
+            std::lock_guard<std::mutex> lock(pShard->m_mtx);
+            total += fn(pShard->m_cache);
+        }
+        return total;
+    }
+};
+
+#endif // __LRUCACHE_H__
@@ -0,0 +1,132 @@
+#ifndef __MULTIQUEUE_H__
+#define __MULTIQUEUE_H__
+
+#include <iostream>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include "../general/types.h"
+#include "heap.h"
+
+// Cola de prioridad concurrente "relajada" (MultiQueue).
+//  - nQueues = c * p heaps (CHeap), cada uno con su mutex y su linea de cache.
+//  - Push: a un heap al azar (si esta ocupado, se prueba otro).
+//  - TryPop: mira el tope cacheado de dos heaps al azar y saca del mejor.
+//  - No respeta el orden de prioridad estricto: el elemento sacado no
+//    siempre es el mejor global (es una cola de prioridad relajada);
+//    el "rank error" esperado crece con c y con la cantidad de hilos pero no
+//    depende del tamano. A cambio escala casi lineal con los hilos.
+// value_type debe ser trivialmente copiable (el tope se publica en un atomic).
+template <typename Traits, size_t D = 4>
+class CMultiQueue {
+public:
+    using  value_type  = typename Traits::value_type;
+    using  CompareFunc = typename Traits::CompareFunc;
+    using  Heap        = CHeap<Traits, D>;
+    static_assert(std::is_trivially_copyable<value_type>::value,
+                  "CMultiQueue: value_type debe ser trivialmente copiable");
+private:
+    struct alignas(64) Queue{
+        std::mutex              m_mtx;
+        Heap                    m_heap;
+        std::atomic<value_type> m_top{};        // valido si !m_empty
+        std::atomic<bool>       m_empty{true};
+
+        void Publish(){
+            if( m_heap.empty() )
+                m_empty.store(true, std::memory_order_release);
+            else{
+                m_top.store(m_heap.Top(), std::memory_order_relaxed);
+                m_empty.store(false, std::memory_order_release);
+            }
+        }
+    };
+    std::vector<Queue *> m_queues;
+    CompareFunc          comp;
+public:
+    // c: factor de relajacion (heaps por hilo)
+    CMultiQueue(size_t nThreads, size_t c = 2){
+        size_t n = nThreads * c < 2 ? 2 : nThreads * c;
+        for(size_t i = 0; i < n; ++i)
+            m_queues.push_back(new Queue);
+    }
+    CMultiQueue(const CMultiQueue &) = delete;
+    CMultiQueue &operator=(const CMultiQueue &) = delete;
+    virtual ~CMultiQueue(){
+        for(auto pQueue : m_queues)
+            delete pQueue;
+    }
+
+    void Push(const value_type &val, ref_type ref = -1){
+        while( true ){
+            Queue &queue = *m_queues[Random() % m_queues.size()];
+            std::unique_lock<std::mutex> lock(queue.m_mtx, std::try_to_lock);
+            if( !lock.owns_lock() )
+                continue;
+            queue.m_heap.Push(val, ref);
+            queue.Publish();
+            return;
+        }
+    }
+    // false solo si todos los heaps estaban vacios al revisarlos
+    bool TryPop(value_type &val, ref_type &ref){
+        for(size_t tries = 0; tries < 2 * m_queues.size(); ++tries){
+            Queue *pQueue = Better(m_queues[Random() % m_queues.size()],
+                                   m_queues[Random() % m_queues.size()]);
+            if( !pQueue )
+                continue;
+            std::unique_lock<std::mutex> lock(pQueue->m_mtx, std::try_to_lock);
+            if( lock.owns_lock() && PopLocked(*pQueue, val, ref) )
+                return true;
+        }
+        // Parecen vacios: barrido completo bloqueando
+        for(auto pQueue : m_queues){
+            std::lock_guard<std::mutex> lock(pQueue->m_mtx);
+            if( PopLocked(*pQueue, val, ref) )
+                return true;
+        }
+        return false;
+    }
+    bool TryPop(value_type &val){
+        ref_type ref;
+        return TryPop(val, ref);
+    }
+
+    size_t getQueues() const { return m_queues.size(); }
+    // Aproximado si hay actividad concurrente
+    size_t getSize(){
+        size_t total = 0;
+        for(auto pQueue : m_queues){
+            std::lock_guard<std::mutex> lock(pQueue->m_mtx);
+            total += pQueue->m_heap.getSize();
+        }
+        return total;
+    }
+private:
+    static uint64_t Random(){
+        thread_local uint64_t state = 0x9E3779B97F4A7C15ULL ^ reinterpret_cast<uintptr_t>(&state);
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    // El de mejor tope entre a y b (nullptr si ambos vacios)
+    Queue *Better(Queue *a, Queue *b){
+        bool emptyA = a->m_empty.load(std::memory_order_acquire);
+        bool emptyB = b->m_empty.load(std::memory_order_acquire);
+        if( emptyA || emptyB )
+            return emptyA ? (emptyB ? nullptr : b) : a;
+        return comp(a->m_top.load(std::memory_order_relaxed), b->m_top.load(std::memory_order_relaxed)) ? b : a;
+    }
+    bool PopLocked(Queue &queue, value_type &val, ref_type &ref){
+        if( queue.m_heap.empty() )
+            return false;
+        val = queue.m_heap.Pop(ref);
+        queue.Publish();
+        return true;
+    }
+};
+
+#endif // __MULTIQUEUE_H__
@@ -0,0 +1,168 @@
+#ifndef __NODEPOOL_H__
+#define __NODEPOOL_H__
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+// Asignadores de nodos para contenedores enlazados.
+// Ambos exponen la misma interfaz:
+//   Node *New(args...)   construye un nodo
+//   void  Delete(Node *) destruye y devuelve el nodo
+//   void  Release()      libera TODO de golpe (solo si bulk_release)
+
+// Asignador clasico: un new/delete por nodo
+template <typename Node>
+class CNewAllocator{
+public:
+    static constexpr bool bulk_release = false;
+
+    template <typename ...Args>
+    Node *New(Args&&... args){ return new Node(std::forward<Args>(args)...); }
+    void  Delete(Node *pNode){ delete pNode; }
+    void  Release(){}
+    void  Absorb(CNewAllocator &&){}
+};
+
+// Pool por bloques (slab): los nodos viven contiguos en chunks de
+// NodesPerChunk elementos; los nodos liberados se reciclan via free list
+// y el destructor libera la memoria en O(chunks).
+template <typename Node, size_t NodesPerChunk = 256>
+class CNodePool{
+    union Slot{
+        Slot *m_pNextFree;
+        alignas(Node) unsigned char m_storage[sizeof(Node)];
+    };
+    struct Chunk{
+        Chunk *m_pNext = nullptr;
+        Slot   m_slots[NodesPerChunk];
+    };
+
+    Chunk *m_pChunks   = nullptr;   // el primero es el chunk "activo"
+    Chunk *m_pLastChunk = nullptr;
+    Slot  *m_pFree     = nullptr;
+    Slot  *m_pFreeTail = nullptr;   // para que Absorb sea O(1)
+    size_t m_nUsed     = NodesPerChunk;  // slots usados del chunk activo
+    size_t m_nChunks   = 0;
+public:
+    static constexpr bool bulk_release = true;
+
+    CNodePool(){}
+    CNodePool(const CNodePool &) = delete;
+    CNodePool &operator=(const CNodePool &) = delete;
+    CNodePool(CNodePool &&another) noexcept
+        : m_pChunks   (std::exchange(another.m_pChunks,    nullptr)),
+          m_pLastChunk(std::exchange(another.m_pLastChunk, nullptr)),
+          m_pFree     (std::exchange(another.m_pFree,      nullptr)),
+          m_pFreeTail (std::exchange(another.m_pFreeTail,  nullptr)),
+          m_nUsed     (std::exchange(another.m_nUsed,      NodesPerChunk)),
+          m_nChunks   (std::exchange(another.m_nChunks,    0)){}
+    CNodePool &operator=(CNodePool &&another) noexcept{
+        if( this != &another ){
+            Release();
+            m_pChunks    = std::exchange(another.m_pChunks,    nullptr);
+            m_pLastChunk = std::exchange(another.m_pLastChunk, nullptr);
+            m_pFree      = std::exchange(another.m_pFree,      nullptr);
+            m_pFreeTail  = std::exchange(another.m_pFreeTail,  nullptr);
+            m_nUsed      = std::exchange(another.m_nUsed,      NodesPerChunk);
+            m_nChunks    = std::exchange(another.m_nChunks,    0);
+        }
+        return *this;
+    }
+    virtual ~CNodePool(){ Release(); }
+
+    template <typename ...Args>
+    Node *New(Args&&... args){
+        Slot *pSlot = m_pFree;
+        if( pSlot ){
+            if( !(m_pFree = pSlot->m_pNextFree) )
+                m_pFreeTail = nullptr;
+        }
+        else{
+            if( m_nUsed == NodesPerChunk ){
+                Chunk *pChunk = new Chunk;
+                pChunk->m_pNext = m_pChunks;
+                if( !m_pChunks )
+                    m_pLastChunk = pChunk;
+                m_pChunks = pChunk;
+                m_nUsed   = 0;
+                ++m_nChunks;
+            }
+            pSlot = &m_pChunks->m_slots[m_nUsed++];
+        }
+        return new (pSlot->m_storage) Node(std::forward<Args>(args)...);
+    }
+
+    void Delete(Node *pNode){
+        pNode->~Node();
+        PushFree(reinterpret_cast<Slot *>(pNode));
+    }
+
+    // No llama destructores: el contenedor decide si hace falta
+    void Release(){
+        while( m_pChunks ){
+            Chunk *pNext = m_pChunks->m_pNext;
+            delete m_pChunks;
+            m_pChunks = pNext;
+        }
+        m_pLastChunk = nullptr;
+        m_pFree      = m_pFreeTail = nullptr;
+        m_nUsed      = NodesPerChunk;
+        m_nChunks    = 0;
+    }
+
+    // Adopta todos los chunks de 'another' (sus nodos vivos pasan a ser
+    // nuestros) para poder reenlazar nodos entre contenedores sin copiar.
+    // O(1): a lo sumo recorre los slots libres de un chunk activo.
+    void Absorb(CNodePool &&another){
+        if( this == &another || !another.m_pChunks )
+            return;
+        if( m_nUsed == NodesPerChunk ){
+            // Nuestro chunk activo esta lleno: el de 'another' pasa a ser el activo
+            another.m_pLastChunk->m_pNext = m_pChunks;
+            if( !m_pChunks )
+                m_pLastChunk = another.m_pLastChunk;
+            m_pChunks = another.m_pChunks;
+            m_nUsed   = another.m_nUsed;
+        }
+        else{
+            // Los slots nunca usados del chunk activo de 'another' van a la free list
+            for(size_t i = another.m_nUsed; i < NodesPerChunk; ++i)
+                another.PushFree(&another.m_pChunks->m_slots[i]);
+            another.m_pLastChunk->m_pNext = m_pChunks->m_pNext;   // el activo sigue primero
+            if( m_pLastChunk == m_pChunks )
+                m_pLastChunk = another.m_pLastChunk;
+            m_pChunks->m_pNext = another.m_pChunks;
+        }
+        if( another.m_pFree ){
+            another.m_pFreeTail->m_pNextFree = m_pFree;
+            if( !m_pFree )
+                m_pFreeTail = another.m_pFreeTail;
+            m_pFree = another.m_pFree;
+        }
+        m_nChunks += another.m_nChunks;
+        another.m_pChunks = another.m_pLastChunk = nullptr;
+        another.m_pFree   = another.m_pFreeTail  = nullptr;
+        another.m_nUsed   = NodesPerChunk;
+        another.m_nChunks = 0;
+    }
+
+    size_t GetChunks() const { return m_nChunks; }
+private:
+    void PushFree(Slot *pSlot){
+        pSlot->m_pNextFree = m_pFree;
+        if( !m_pFree )
+            m_pFreeTail = pSlot;
+        m_pFree = pSlot;
+    }
+};
+
+// Ayuda para contenedores: destruye los nodos uno a uno solo cuando
+// el asignador no puede liberar en bloque o el nodo no es trivial.
+template <typename Allocator, typename Node>
+constexpr bool CanBulkRelease(){
+    return Allocator::bulk_release && std::is_trivially_destructible<Node>::value;
+}
+
+#endif // __NODEPOOL_H__
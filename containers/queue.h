@@ -2,12 +2,447 @@
 #define __QUEUE_H__
 
 #include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
 #include "../general/types.h"
 #include "../util.h"
 
-class CQueue{
-    
+// Las colas se arman con un Storage elegido por Traits:
+//   CQueue< SPSCQueueTrait<int> > q(1024);
+// CQueue hereda la interfaz del Storage (TryPush/TryPop, ...).
+template <typename T, template <typename> class _Storage>
+struct QueueTrait{
+    using value_type = T;
+    template <typename U>
+    using Storage    = _Storage<U>;
 };
 
+constexpr size_t QueueCacheLine = 64;
 
-#endif // __QUEUE_H__
\ No newline at end of file
+inline size_t RoundUpPow2(size_t n){
+    size_t p = 2;
+    while( p < n )
+        p *= 2;
+    return p;
+}
+
+// Ring buffer acotado para UN productor y UN consumidor, sin locks.
+//  - Capacidad potencia de 2: la posicion es index & mask.
+//  - m_tail (lo escribe el productor) y m_head (el consumidor) en lineas de
+//    cache distintas; cada lado guarda una copia del indice del otro y solo
+//    la relee (acquire) cuando la copia dice lleno/vacio.
+//  - PushN/PopN publican un lote con un unico store.
+template <typename T>
+class CSPSCRing{
+public:
+    using value_type = T;
+private:
+    alignas(QueueCacheLine) std::atomic<size_t> m_tail{0};     // productor
+    size_t                  m_cachedHead = 0;
+    alignas(QueueCacheLine) std::atomic<size_t> m_head{0};     // consumidor
+    size_t                  m_cachedTail = 0;
+    alignas(QueueCacheLine) size_t m_mask;
+    std::unique_ptr<T[]>    m_buffer;
+public:
+    explicit CSPSCRing(size_t capacity)
+        : m_mask(RoundUpPow2(capacity) - 1), m_buffer(new T[m_mask + 1]){}
+    CSPSCRing(const CSPSCRing &) = delete;
+    CSPSCRing &operator=(const CSPSCRing &) = delete;
+
+    // --- solo el productor ---
+    bool TryPush(const T &val){ return Emplace(val);            }
+    bool TryPush(T &&val)     { return Emplace(std::move(val)); }
+    // Encola hasta n elementos; devuelve cuantos entraron
+    size_t PushN(const T *pValues, size_t n){
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t free = m_mask + 1 - (tail - m_cachedHead);
+        if( free < n ){
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            free = m_mask + 1 - (tail - m_cachedHead);
+        }
+        n = n < free ? n : free;
+        for(size_t i = 0; i < n; ++i)
+            m_buffer[(tail + i) & m_mask] = pValues[i];
+        m_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // --- solo el consumidor ---
+    bool TryPop(T &val){
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if( head == m_cachedTail ){
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if( head == m_cachedTail )
+                return false;
+        }
+        val = std::move(m_buffer[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    size_t PopN(T *pValues, size_t n){
+        size_t head  = m_head.load(std::memory_order_relaxed);
+        size_t avail = m_cachedTail - head;
+        if( avail < n ){
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            avail = m_cachedTail - head;
+        }
+        n = n < avail ? n : avail;
+        for(size_t i = 0; i < n; ++i)
+            pValues[i] = std::move(m_buffer[(head + i) & m_mask]);
+        m_head.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // Aproximado si hay actividad concurrente
+    size_t getSize() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+    size_t getCapacity() const { return m_mask + 1;     }
+    bool   empty()       const { return getSize() == 0; }
+private:
+    template <typename U>
+    bool Emplace(U &&val){
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if( tail - m_cachedHead > m_mask ){
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if( tail - m_cachedHead > m_mask )
+                return false;
+        }
+        m_buffer[tail & m_mask] = std::forward<U>(val);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+template <typename T>
+struct SPSCQueueTrait : public QueueTrait<T, CSPSCRing>{};
+
+// Cola acotada para VARIOS productores y consumidores (Vyukov).
+//  - Cada slot tiene un numero de secuencia: seq == pos  -> libre para el
+//    productor de 'pos'; seq == pos + 1 -> listo para el consumidor de 'pos'.
+//  - Productores y consumidores solo compiten por un CAS sobre su propio
+//    contador (m_enqueuePos / m_dequeuePos), cada uno en su linea de cache.
+//  - Push/Pop bloqueantes: giran SpinCount intentos y luego duermen en una
+//    condition_variable; el otro lado solo toma el mutex si hay alguien
+//    esperando, asi el camino rapido no paga ningun lock.
+template <typename T>
+class CMPMCRing{
+public:
+    using value_type = T;
+    static constexpr unsigned SpinCount = 128;
+private:
+    struct Slot{
+        std::atomic<size_t> m_seq;
+        T                   m_data;
+    };
+    alignas(QueueCacheLine) std::atomic<size_t> m_enqueuePos{0};
+    alignas(QueueCacheLine) std::atomic<size_t> m_dequeuePos{0};
+    alignas(QueueCacheLine) size_t m_mask;
+    std::unique_ptr<Slot[]>     m_slots;
+    // Estacionamiento de los bloqueantes
+    alignas(QueueCacheLine) std::mutex m_mtx;
+    std::condition_variable     m_notEmpty, m_notFull;
+    std::atomic<unsigned>       m_nWaitingPop{0}, m_nWaitingPush{0};
+public:
+    explicit CMPMCRing(size_t capacity)
+        : m_mask(RoundUpPow2(capacity) - 1), m_slots(new Slot[m_mask + 1]){
+        for(size_t i = 0; i <= m_mask; ++i)
+            m_slots[i].m_seq.store(i, std::memory_order_relaxed);
+    }
+    CMPMCRing(const CMPMCRing &) = delete;
+    CMPMCRing &operator=(const CMPMCRing &) = delete;
+
+    bool TryPush(const T &val){ return TryEmplace(val);            }
+    bool TryPush(T &&val)     { return TryEmplace(std::move(val)); }
+    bool TryPop(T &val){
+        if( !TryPopNoWake(val) )
+            return false;
+        Wake(m_nWaitingPush, m_notFull);
+        return true;
+    }
+
+    void Push(T val){
+        Block(m_nWaitingPush, m_notFull, [&](){ return TryEmplace(std::move(val), false); });
+        Wake(m_nWaitingPop, m_notEmpty);
+    }
+    void Pop(T &val){
+        Block(m_nWaitingPop, m_notEmpty, [&](){ return TryPopNoWake(val); });
+        Wake(m_nWaitingPush, m_notFull);
+    }
+
+    size_t getSize() const {
+        size_t tail = m_enqueuePos.load(std::memory_order_acquire);
+        size_t head = m_dequeuePos.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+    size_t getCapacity() const { return m_mask + 1;     }
+    bool   empty()       const { return getSize() == 0; }
+private:
+    template <typename U>
+    bool TryEmplace(U &&val, bool wake = true){
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        while( true ){
+            Slot     &slot = m_slots[pos & m_mask];
+            size_t    seq  = slot.m_seq.load(std::memory_order_acquire);
+            ptrdiff_t diff = ptrdiff_t(seq) - ptrdiff_t(pos);
+            if( diff == 0 ){
+                if( m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) ){
+                    slot.m_data = std::forward<U>(val);
+                    slot.m_seq.store(pos + 1, std::memory_order_release);
+                    if( wake )
+                        Wake(m_nWaitingPop, m_notEmpty);
+                    return true;
+                }
+            }
+            else if( diff < 0 )
+                return false;                   // llena
+            else
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    bool TryPopNoWake(T &val){
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        while( true ){
+            Slot     &slot = m_slots[pos & m_mask];
+            size_t    seq  = slot.m_seq.load(std::memory_order_acquire);
+            ptrdiff_t diff = ptrdiff_t(seq) - ptrdiff_t(pos + 1);
+            if( diff == 0 ){
+                if( m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) ){
+                    val = std::move(slot.m_data);
+                    slot.m_seq.store(pos + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if( diff < 0 )
+                return false;                   // vacia
+            else
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Los fences seq_cst de ambos lados evitan la senal perdida: o el que
+    // espera ve el cambio al reintentar, o el que avisa ve al que espera.
+    template <typename Try>
+    void Block(std::atomic<unsigned> &nWaiting, std::condition_variable &cv, Try tryOp){
+        for(unsigned i = 0; i < SpinCount; ++i){
+            if( tryOp() )
+                return;
+            if( i >= SpinCount / 2 )
+                std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(m_mtx);
+        nWaiting.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while( !tryOp() )
+            cv.wait(lock);
+        nWaiting.fetch_sub(1);
+    }
+    void Wake(std::atomic<unsigned> &nWaiting, std::condition_variable &cv){
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if( nWaiting.load(std::memory_order_relaxed) ){
+            std::lock_guard<std::mutex> lock(m_mtx);
+            cv.notify_all();
+        }
+    }
+};
+
+template <typename T>
+struct MPMCQueueTrait : public QueueTrait<T, CMPMCRing>{};
+
+// Deque por bloques (un solo hilo), sin limite de tamano:
+//  - Los elementos viven en bloques de BlockSize; un mapa de punteros a
+//    bloques crece en forma geometrica (o se recentra) y solo copia punteros.
+//  - Nunca mueve un elemento ya insertado: referencias y punteros a los
+//    elementos siguen validos hasta que ese elemento se saca.
+//  - Los bloques vacios vuelven a una free list (enlazada dentro del mismo
+//    bloque) y se reutilizan; ShrinkToFit() los devuelve al sistema.
+template <typename T>
+class CChunkedDeque{
+public:
+    using value_type = T;
+    static constexpr size_t BlockBytes = 4096;
+    static constexpr size_t BlockSize  = BlockBytes / sizeof(T) > 16 ? BlockBytes / sizeof(T) : 16;
+private:
+    struct alignas(T) Raw{ unsigned char m_bytes[sizeof(T)]; };
+    struct FreeBlock{ FreeBlock *m_pNext; };
+
+    T        **m_map       = nullptr;
+    size_t     m_mapSize   = 0;
+    size_t     m_first     = 0;         // primer bloque usado en el mapa
+    size_t     m_nBlocks   = 0;         // bloques usados
+    size_t     m_head      = 0;         // offset del primer elemento en su bloque
+    size_t     m_nElements = 0;
+    FreeBlock *m_pFree     = nullptr;
+public:
+    explicit CChunkedDeque(size_t capacity = 0){
+        for(size_t i = 0; i < (capacity + BlockSize - 1) / BlockSize; ++i)
+            FreeBlockRet(NewBlock());
+    }
+    CChunkedDeque(const CChunkedDeque &another){
+        for(size_t i = 0; i < another.getSize(); ++i)
+            push_back(another[i]);
+    }
+    CChunkedDeque(CChunkedDeque &&another) noexcept
+        : m_map      (std::exchange(another.m_map, nullptr)),
+          m_mapSize  (std::exchange(another.m_mapSize, 0)),
+          m_first    (std::exchange(another.m_first, 0)),
+          m_nBlocks  (std::exchange(another.m_nBlocks, 0)),
+          m_head     (std::exchange(another.m_head, 0)),
+          m_nElements(std::exchange(another.m_nElements, 0)),
+          m_pFree    (std::exchange(another.m_pFree, nullptr)){}
+    CChunkedDeque &operator=(const CChunkedDeque &) = delete;
+    virtual ~CChunkedDeque(){
+        Clear();
+        ShrinkToFit();
+        delete [] m_map;
+    }
+
+    void push_back(const T &val){ emplace_back(val);            }
+    void push_back(T &&val)     { emplace_back(std::move(val)); }
+    void push_front(const T &val){ emplace_front(val);            }
+    void push_front(T &&val)     { emplace_front(std::move(val)); }
+    template <typename... Args>
+    T &emplace_back(Args&&... args){
+        size_t pos = m_head + m_nElements;
+        if( pos / BlockSize == m_nBlocks ){
+            if( m_first + m_nBlocks == m_mapSize )
+                GrowMap();
+            m_map[m_first + m_nBlocks++] = PopFreeBlock();
+        }
+        T *p = new (&m_map[m_first + pos / BlockSize][pos % BlockSize]) T(std::forward<Args>(args)...);
+        ++m_nElements;
+        return *p;
+    }
+    template <typename... Args>
+    T &emplace_front(Args&&... args){
+        if( m_head == 0 ){
+            if( m_first == 0 )
+                GrowMap();
+            m_map[--m_first] = PopFreeBlock();
+            ++m_nBlocks;
+            m_head = BlockSize;
+        }
+        T *p = new (&m_map[m_first][m_head - 1]) T(std::forward<Args>(args)...);
+        --m_head;
+        ++m_nElements;
+        return *p;
+    }
+    void pop_front(){
+        m_map[m_first][m_head].~T();
+        --m_nElements;
+        if( ++m_head == BlockSize ){
+            FreeBlockRet(m_map[m_first++]);
+            --m_nBlocks;
+            m_head = 0;
+        }
+        else if( m_nElements == 0 )
+            ReleaseTail();
+    }
+    void pop_back(){
+        size_t pos = m_head + --m_nElements;
+        m_map[m_first + pos / BlockSize][pos % BlockSize].~T();
+        ReleaseTail();
+    }
+
+    // Interfaz de cola (FIFO): mismo estilo que los demas Storage
+    bool TryPush(const T &val){ push_back(val);            return true; }
+    bool TryPush(T &&val)     { push_back(std::move(val)); return true; }
+    bool TryPop(T &val){
+        if( empty() )
+            return false;
+        val = std::move(front());
+        pop_front();
+        return true;
+    }
+
+    T       &operator[](size_t i)      { size_t pos = m_head + i; return m_map[m_first + pos / BlockSize][pos % BlockSize]; }
+    const T &operator[](size_t i) const{ size_t pos = m_head + i; return m_map[m_first + pos / BlockSize][pos % BlockSize]; }
+    T       &front()                   { return (*this)[0];               }
+    T       &back()                    { return (*this)[m_nElements - 1]; }
+
+    size_t getSize()   const { return m_nElements;      }
+    bool   empty()     const { return m_nElements == 0; }
+    size_t getBlocks() const { return m_nBlocks;        }
+
+    void Clear(){
+        while( m_nElements )
+            pop_back();
+    }
+    // Devuelve al sistema los bloques de la free list
+    void ShrinkToFit(){
+        while( m_pFree ){
+            FreeBlock *pNext = m_pFree->m_pNext;
+            delete [] reinterpret_cast<Raw *>(m_pFree);
+            m_pFree = pNext;
+        }
+    }
+
+    template <typename Func2, typename... Args>
+    void Foreach(Func2 fn, Args... args){
+        for(size_t i = 0; i < m_nElements; ++i)
+            fn((*this)[i], args...);
+    }
+private:
+    static T *NewBlock(){ return reinterpret_cast<T *>(new Raw[BlockSize]); }
+    T *PopFreeBlock(){
+        if( !m_pFree )
+            return NewBlock();
+        FreeBlock *pBlock = m_pFree;
+        m_pFree = pBlock->m_pNext;
+        return reinterpret_cast<T *>(pBlock);
+    }
+    void FreeBlockRet(T *pBlock){
+        FreeBlock *pFree = reinterpret_cast<FreeBlock *>(pBlock);
+        pFree->m_pNext = m_pFree;
+        m_pFree = pFree;
+    }
+    // Libera el ultimo bloque si ya no tiene elementos
+    void ReleaseTail(){
+        size_t used = (m_head + m_nElements + BlockSize - 1) / BlockSize;
+        if( m_nElements == 0 ){
+            used   = 0;
+            m_head = 0;
+        }
+        while( m_nBlocks > used )
+            FreeBlockRet(m_map[m_first + --m_nBlocks]);
+    }
+    // Recentra los bloques usados; duplica el mapa solo si esta a mas de la mitad
+    void GrowMap(){
+        size_t newSize = m_mapSize;
+        if( m_nBlocks + 2 > m_mapSize / 2 )
+            newSize = m_mapSize ? 2 * m_mapSize : 8;
+        size_t newFirst = (newSize - m_nBlocks) / 2;
+        if( newSize == m_mapSize ){
+            std::memmove(m_map + newFirst, m_map + m_first, m_nBlocks * sizeof(T *));
+        }
+        else{
+            T **pMap = new T *[newSize];
+            std::copy(m_map + m_first, m_map + m_first + m_nBlocks, pMap + newFirst);
+            delete [] m_map;
+            m_map     = pMap;
+            m_mapSize = newSize;
+        }
+        m_first = newFirst;
+    }
+};
+
+template <typename T>
+struct DequeQueueTrait : public QueueTrait<T, CChunkedDeque>{};
+
+template <typename Traits>
+class CQueue : public Traits::template Storage<typename Traits::value_type>{
+public:
+    using  value_type = typename Traits::value_type;
+    using  Storage    = typename Traits::template Storage<value_type>;
+    using  Storage::Storage;
+};
+
+#endif // __QUEUE_H__
@@ -0,0 +1,211 @@
+#ifndef __SKIPLIST_H__
+#define __SKIPLIST_H__
+#include <iostream>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "../general/types.h"
+#include "linkedlist.h"
+
+// Lista ordenada con indice skip list: misma interfaz Insert(val, ref) que
+// CLinkedList y los mismos Traits (Func decide el orden), pero Insert, Find,
+// LowerBound y Remove son O(log n) esperado y todo es iterativo.
+// El nivel 0 es una lista enlazada normal: begin()/end() la recorren en orden.
+
+template <typename Traits>
+class NodeSkipList{
+    using  value_type  = typename Traits::value_type;
+    using  Node        = NodeSkipList<Traits>;
+private:
+    value_type m_data;
+    ref_type   m_ref;
+    int        m_nLevels;
+    Node      *m_pNext[1];      // en realidad m_nLevels punteros (ver Create)
+
+    NodeSkipList(const value_type &_value, ref_type _ref, int nLevels)
+        : m_data(_value), m_ref(_ref), m_nLevels(nLevels){
+        for(int i = 0; i < nLevels; ++i)
+            m_pNext[i] = nullptr;
+    }
+public:
+    static Node *Create(const value_type &_value, ref_type _ref, int nLevels){
+        void *pMem = ::operator new(sizeof(Node) + (nLevels - 1) * sizeof(Node *));
+        return new (pMem) Node(_value, _ref, nLevels);
+    }
+    static void Destroy(Node *pNode){
+        pNode->~Node();
+        ::operator delete(pNode);
+    }
+
+    value_type  GetValue   () const { return m_data; }
+    value_type &GetValueRef()       { return m_data; }
+    ref_type    GetRef     () const { return m_ref;  }
+    ref_type   &GetRefRef  ()       { return m_ref;  }
+    int         GetLevels  () const { return m_nLevels; }
+
+    Node  *GetNext   (int level = 0) const { return m_pNext[level]; }
+    Node *&GetNextRef(int level = 0)       { return m_pNext[level]; }
+};
+
+template <typename Traits>
+class CSkipList {
+public:
+    using  value_type  = typename Traits::value_type;
+    using  Node        = NodeSkipList<Traits>;
+    using  Func        = typename Traits::Func;
+    using  forward_iterator  = LinkedListForwardIterator < CSkipList<Traits> >;
+    static constexpr int MaxLevel = 24;     // 4^24 elementos esperados
+private:
+    Node    *m_pHead = nullptr;             // centinela con MaxLevel punteros
+    int      m_nLevels   = 1;
+    size_t   m_nElements = 0;
+    uint64_t m_seed      = 0x9E3779B97F4A7C15ULL;
+    Func     comp;
+public:
+    CSkipList(){ m_pHead = Node::Create(value_type(), -1, MaxLevel); }
+    CSkipList(const CSkipList &another);
+    // El origen queda vacio con un centinela nuevo: pedirlo puede lanzar
+    CSkipList(CSkipList &&another);
+    virtual ~CSkipList();
+
+    void Insert(const value_type &val, ref_type ref);
+    bool Remove(const value_type &val);
+    forward_iterator LowerBound(const value_type &val);
+    forward_iterator Find(const value_type &val);
+    bool Contains(const value_type &val) { return Find(val) != end(); }
+    void Clear();
+    size_t getSize(){ return m_nElements;  }
+
+    forward_iterator begin() { return forward_iterator(m_pHead->GetNext());  }
+    forward_iterator end()   { return forward_iterator(nullptr);  }
+private:
+    int  RandomLevel();
+    // Deja en update[i] el ultimo nodo del nivel i que va antes de 'val'
+    template <typename Before>
+    Node *FindPredecessors(const value_type &val, Before before, Node **update);
+
+    friend ostream &operator<<(ostream &os, CSkipList<Traits> &container){
+        os << "CSkipList: size = " << container.getSize() << endl;
+        os << "[";
+        for(Node *pNode = container.m_pHead->GetNext(); pNode; pNode = pNode->GetNext())
+            os << "(" << pNode->GetValue() << ":" << pNode->GetRef() << "),";
+        os << "]" << endl;
+        return os;
+    }
+};
+
+template <typename Traits>
+CSkipList<Traits>::CSkipList(const CSkipList &another) : CSkipList(){
+    for(Node *pNode = another.m_pHead->GetNext(); pNode; pNode = pNode->GetNext())
+        Insert(pNode->GetValue(), pNode->GetRef());
+}
+
+template <typename Traits>
+CSkipList<Traits>::CSkipList(CSkipList &&another)
+    : m_pHead    (std::exchange(another.m_pHead, Node::Create(value_type(), -1, MaxLevel))),
+      m_nLevels  (std::exchange(another.m_nLevels, 1)),
+      m_nElements(std::exchange(another.m_nElements, 0)),
+      m_seed     (another.m_seed){
+}
+
+template <typename Traits>
+CSkipList<Traits>::~CSkipList(){
+    Clear();
+    Node::Destroy(m_pHead);
+}
+
+template <typename Traits>
+void CSkipList<Traits>::Clear(){
+    Node *pNode = m_pHead->GetNext();
+    while( pNode ){
+        Node *pNext = pNode->GetNext();
+        Node::Destroy(pNode);
+        pNode = pNext;
+    }
+    for(int i = 0; i < MaxLevel; ++i)
+        m_pHead->GetNextRef(i) = nullptr;
+    m_nLevels   = 1;
+    m_nElements = 0;
+}
+
+// p = 1/4 por nivel (xorshift64)
+template <typename Traits>
+int CSkipList<Traits>::RandomLevel(){
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 7;
+    m_seed ^= m_seed << 17;
+    uint64_t bits = m_seed;
+    int level = 1;
+    while( level < MaxLevel && (bits & 3) == 0 ){
+        ++level;
+        bits >>= 2;
+    }
+    return level;
+}
+
+template <typename Traits>
+template <typename Before>
+typename CSkipList<Traits>::Node *
+CSkipList<Traits>::FindPredecessors(const value_type &val, Before before, Node **update){
+    Node *pCurrent = m_pHead;
+    for(int level = m_nLevels - 1; level >= 0; --level){
+        Node *pNext = pCurrent->GetNext(level);
+        while( pNext && before(pNext->GetValue(), val) ){
+            pCurrent = pNext;
+            pNext    = pCurrent->GetNext(level);
+        }
+        if( update )
+            update[level] = pCurrent;
+    }
+    return pCurrent->GetNext();
+}
+
+// Igual que CLinkedList: los iguales quedan en orden de llegada
+template <typename Traits>
+void CSkipList<Traits>::Insert(const value_type &val, ref_type ref){
+    Node *update[MaxLevel];
+    FindPredecessors(val, [this](const value_type &a, const value_type &b){ return !comp(a, b); }, update);
+    int level = RandomLevel();
+    for(; m_nLevels < level; ++m_nLevels)
+        update[m_nLevels] = m_pHead;
+    Node *pNew = Node::Create(val, ref, level);
+    for(int i = 0; i < level; ++i){
+        pNew->GetNextRef(i)       = update[i]->GetNext(i);
+        update[i]->GetNextRef(i)  = pNew;
+    }
+    ++m_nElements;
+}
+
+// Primer elemento que no va antes de 'val'
+template <typename Traits>
+typename CSkipList<Traits>::forward_iterator CSkipList<Traits>::LowerBound(const value_type &val){
+    return forward_iterator(FindPredecessors(val,
+        [this](const value_type &a, const value_type &b){ return comp(b, a); }, nullptr));
+}
+
+template <typename Traits>
+typename CSkipList<Traits>::forward_iterator CSkipList<Traits>::Find(const value_type &val){
+    Node *pNode = FindPredecessors(val,
+        [this](const value_type &a, const value_type &b){ return comp(b, a); }, nullptr);
+    if( pNode && !comp(pNode->GetValue(), val) && !comp(val, pNode->GetValue()) )
+        return forward_iterator(pNode);
+    return end();
+}
+
+template <typename Traits>
+bool CSkipList<Traits>::Remove(const value_type &val){
+    Node *update[MaxLevel];
+    Node *pNode = FindPredecessors(val,
+        [this](const value_type &a, const value_type &b){ return comp(b, a); }, update);
+    if( !pNode || comp(pNode->GetValue(), val) || comp(val, pNode->GetValue()) )
+        return false;
+    for(int i = 0; i < pNode->GetLevels(); ++i)
+        update[i]->GetNextRef(i) = pNode->GetNext(i);
+    Node::Destroy(pNode);
+    while( m_nLevels > 1 && !m_pHead->GetNext(m_nLevels - 1) )
+        --m_nLevels;
+    --m_nElements;
+    return true;
+}
+
+#endif // __SKIPLIST_H__
@@ -2,8 +2,245 @@
 #define __STACK_H__
 
 #include <iostream>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
 #include "../general/types.h"
+#include "epoch.h"
 
+// Las pilas se arman igual que las colas: un Storage elegido por Traits.
+//   CStack< SegmentedStackTrait<int> > s;
+// CStack hereda la interfaz del Storage (push/pop/top, TryPush/TryPop, ...).
+template <typename T, template <typename> class _Storage>
+struct StackTrait{
+    using value_type = T;
+    template <typename U>
+    using Storage    = _Storage<U>;
+};
 
+// Pila de un solo hilo sobre segmentos enlazados.
+//  - Segmentos de 4 KiB: crecer es enlazar uno nuevo, nunca se copian los
+//    elementos (las referencias a ellos siguen validas).
+//  - Como CChunkedDeque, los segmentos que se vacian se conservan (quedan
+//    enlazados sobre el tope) y se reutilizan: oscilar en el borde o volver
+//    a crecer no pide memoria. ShrinkToFit() los devuelve al sistema.
+template <typename T>
+class CSegmentedStack{
+public:
+    using value_type = T;
+    static constexpr size_t SegmentBytes = 4096;
+    static constexpr size_t SegmentSize  = SegmentBytes / sizeof(T) > 16 ? SegmentBytes / sizeof(T) : 16;
+private:
+    struct Segment{
+        Segment *m_pPrev = nullptr;
+        Segment *m_pNext = nullptr;         // sobre el tope: vacios conservados
+        alignas(T) unsigned char m_data[SegmentSize * sizeof(T)];
+        T *At(size_t i){ return reinterpret_cast<T *>(m_data) + i; }
+    };
+    Segment *m_pTop  = nullptr;             // segmento con el tope
+    size_t   m_top   = SegmentSize;         // elementos usados en m_pTop
+    size_t   m_nElements = 0;
+    size_t   m_nSegments = 0;               // en uso (sin los conservados)
+public:
+    CSegmentedStack(){}
+    CSegmentedStack(const CSegmentedStack &another){
+        const_cast<CSegmentedStack &>(another).Foreach([this](T &val){ push(val); });
+    }
+    CSegmentedStack(CSegmentedStack &&another) noexcept
+        : m_pTop     (std::exchange(another.m_pTop, nullptr)),
+          m_top      (std::exchange(another.m_top, SegmentSize)),
+          m_nElements(std::exchange(another.m_nElements, 0)),
+          m_nSegments(std::exchange(another.m_nSegments, 0)){}
+    CSegmentedStack &operator=(const CSegmentedStack &) = delete;
+    virtual ~CSegmentedStack(){
+        Clear();
+        ShrinkToFit();
+        delete m_pTop;
+    }
 
-#endif // __STACK_H__
\ No newline at end of file
+    void push(const T &val){ emplace(val);            }
+    void push(T &&val)     { emplace(std::move(val)); }
+    template <typename... Args>
+    T &emplace(Args&&... args){
+        if( m_top == SegmentSize )
+            NextSegment();
+        T *p = new (m_pTop->At(m_top)) T(std::forward<Args>(args)...);
+        ++m_top;
+        ++m_nElements;
+        return *p;
+    }
+    // Precondicion: !empty()
+    void pop(){
+        m_pTop->At(--m_top)->~T();
+        --m_nElements;
+        if( m_top == 0 && m_pTop->m_pPrev )
+            PrevSegment();
+    }
+    T       &top()       { return *m_pTop->At(m_top - 1); }
+    const T &top() const { return *m_pTop->At(m_top - 1); }
+
+    // Misma interfaz que los Storage de CQueue
+    bool TryPush(const T &val){ push(val);            return true; }
+    bool TryPush(T &&val)     { push(std::move(val)); return true; }
+    bool TryPop(T &val){
+        if( empty() )
+            return false;
+        val = std::move(top());
+        pop();
+        return true;
+    }
+
+    size_t getSize()     const { return m_nElements;      }
+    bool   empty()       const { return m_nElements == 0; }
+    size_t getSegments() const { return m_nSegments;      }
+
+    void Clear(){
+        while( m_nElements )
+            pop();
+    }
+    // Libera los segmentos conservados sobre el tope
+    void ShrinkToFit(){
+        if( !m_pTop )
+            return;
+        Segment *pSeg = m_pTop->m_pNext;
+        while( pSeg ){
+            Segment *pNext = pSeg->m_pNext;
+            delete pSeg;
+            pSeg = pNext;
+        }
+        m_pTop->m_pNext = nullptr;
+    }
+
+    // De la base al tope
+    template <typename Func2, typename... Args>
+    void Foreach(Func2 fn, Args... args){
+        if( !m_pTop )
+            return;
+        Segment *pSeg = m_pTop;
+        while( pSeg->m_pPrev )
+            pSeg = pSeg->m_pPrev;
+        for(; pSeg; pSeg = pSeg == m_pTop ? nullptr : pSeg->m_pNext){
+            size_t n = pSeg == m_pTop ? m_top : SegmentSize;
+            for(size_t i = 0; i < n; ++i)
+                fn(*pSeg->At(i), args...);
+        }
+    }
+private:
+    void NextSegment(){
+        Segment *pNext = m_pTop ? m_pTop->m_pNext : nullptr;
+        if( !pNext ){
+            pNext = new Segment;
+            pNext->m_pPrev = m_pTop;
+            if( m_pTop )
+                m_pTop->m_pNext = pNext;
+        }
+        m_pTop = pNext;
+        m_top  = 0;
+        ++m_nSegments;
+    }
+    // m_pTop quedo vacio: se conserva enlazado para el proximo NextSegment
+    void PrevSegment(){
+        m_pTop = m_pTop->m_pPrev;
+        m_top  = SegmentSize;
+        --m_nSegments;
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, CSegmentedStack<T> &container){
+        os << "CSegmentedStack: size = " << container.getSize() << std::endl;
+        os << "[";
+        container.Foreach([&os](T &val){ os << val << ","; });
+        os << "]" << std::endl;
+        return os;
+    }
+};
+
+// Pila lock-free de Treiber (LIFO para pools de tareas multi-hilo).
+//  - m_head es un puntero etiquetado: 48 bits de direccion + 16 bits de
+//    contador que cambia en cada CAS exitoso. Un CAS con un m_head viejo
+//    (mismo nodo sacado y vuelto a poner: ABA) falla por la etiqueta.
+//  - Pop lee pHead->m_pNext de un nodo que otro hilo puede estar sacando:
+//    se hace dentro de un CEpochGuard y el nodo sacado se entrega a
+//    Retire(), asi nunca se libera mientras alguien pueda leerlo.
+//  - Push no lee nodos ajenos: no necesita fijar la epoca.
+template <typename T>
+class CTreiberStack{
+public:
+    using value_type = T;
+private:
+    static_assert(sizeof(void *) == 8, "CTreiberStack: requiere punteros de 64 bits (48 usados)");
+    static constexpr unsigned TagShift = 48;
+    static constexpr uint64_t PtrMask  = (uint64_t(1) << TagShift) - 1;
+
+    struct Node{
+        T     m_value;
+        Node *m_pNext;
+    };
+    alignas(64) std::atomic<uint64_t> m_head{0};
+    CEpochReclaimer &m_reclaimer = CEpochReclaimer::Instance();
+
+    static Node    *Pointer(uint64_t word){ return reinterpret_cast<Node *>(word & PtrMask); }
+    static uint64_t Link(Node *pNode, uint64_t oldWord){
+        uint64_t tag = (oldWord >> TagShift) + 1;
+        return (tag << TagShift) | reinterpret_cast<uint64_t>(pNode);
+    }
+public:
+    CTreiberStack(){}
+    CTreiberStack(const CTreiberStack &) = delete;
+    CTreiberStack &operator=(const CTreiberStack &) = delete;
+    // Sin hilos activos: se libera directo
+    virtual ~CTreiberStack(){
+        Node *pNode = Pointer(m_head.load(std::memory_order_acquire));
+        while( pNode ){
+            Node *pNext = pNode->m_pNext;
+            delete pNode;
+            pNode = pNext;
+        }
+    }
+
+    void push(const T &val){ PushNode(new Node{val, nullptr});            }
+    void push(T &&val)     { PushNode(new Node{std::move(val), nullptr}); }
+    bool TryPush(const T &val){ push(val);            return true; }
+    bool TryPush(T &&val)     { push(std::move(val)); return true; }
+    bool TryPop(T &val){
+        CEpochGuard guard(m_reclaimer);
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        while( true ){
+            Node *pHead = Pointer(head);
+            if( !pHead )
+                return false;
+            Node *pNext = pHead->m_pNext;
+            if( m_head.compare_exchange_weak(head, Link(pNext, head),
+                                             std::memory_order_acq_rel, std::memory_order_acquire) ){
+                val = std::move(pHead->m_value);
+                m_reclaimer.Retire(pHead);
+                return true;
+            }
+        }
+    }
+    // Aproximado si hay actividad concurrente
+    bool empty() const { return Pointer(m_head.load(std::memory_order_acquire)) == nullptr; }
+private:
+    void PushNode(Node *pNode){
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        do
+            pNode->m_pNext = Pointer(head);
+        while( !m_head.compare_exchange_weak(head, Link(pNode, head),
+                                             std::memory_order_release, std::memory_order_relaxed) );
+    }
+};
+
+template <typename T>
+struct SegmentedStackTrait : public StackTrait<T, CSegmentedStack>{};
+template <typename T>
+struct TreiberStackTrait   : public StackTrait<T, CTreiberStack>{};
+
+template <typename Traits>
+class CStack : public Traits::template Storage<typename Traits::value_type>{
+public:
+    using  value_type = typename Traits::value_type;
+    using  Storage    = typename Traits::template Storage<value_type>;
+    using  Storage::Storage;
+};
+
+#endif // __STACK_H__
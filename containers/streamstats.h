@@ -0,0 +1,240 @@
+#ifndef __STREAMSTATS_H__
+#define __STREAMSTATS_H__
+
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "../general/types.h"
+#include "heap.h"
+
+// Operadores de flujo sobre CHeap: procesan un elemento por vez, en
+// O(log k), sin guardar el flujo completo. Despues del calentamiento
+// (reserve del constructor) no vuelven a pedir memoria.
+
+// Los K mejores de un flujo, con su ref.
+//  - Heap acotado a K cuyo tope es el peor de los guardados: un valor nuevo
+//    entra solo si le gana al tope (ReplaceTop), si no se descarta en O(1).
+//  - "Mejor" es lo que saldria ultimo de CHeap<Traits>: con
+//    TreeTraitAscending (heap de minimos) se guardan los K mayores.
+template <typename Traits, size_t D = 4>
+class CTopK {
+public:
+    using  value_type  = typename Traits::value_type;
+    using  CompareFunc = typename Traits::CompareFunc;
+    using  Heap        = CHeap<Traits, D>;
+    using  Node        = typename Heap::Node;
+private:
+    Heap        m_heap;
+    size_t      m_k;
+    CompareFunc comp;
+public:
+    explicit CTopK(size_t k) : m_k(k){ m_heap.reserve(k); }
+    virtual ~CTopK(){}
+
+    // Devuelve true si el valor quedo entre los K mejores (por ahora)
+    bool Push(const value_type &val, ref_type ref = -1){
+        if( m_heap.getSize() < m_k ){
+            m_heap.Push(val, ref);
+            return true;
+        }
+        if( m_k == 0 || !comp(val, m_heap.Top()) )
+            return false;
+        m_heap.ReplaceTop(val, ref);
+        return true;
+    }
+    // El peor de los K: un valor nuevo tiene que superarlo para entrar
+    const value_type &Threshold()    const { return m_heap.Top();    }
+    ref_type          ThresholdRef() const { return m_heap.TopRef(); }
+
+    size_t getK()    const { return m_k;              }
+    size_t getSize() const { return m_heap.getSize(); }
+    bool   empty()   const { return m_heap.empty();   }
+    void   Clear()         { m_heap.Clear();          }
+
+    // Sin orden: fn(value, ref)
+    template <typename Func2>
+    void Foreach(Func2 fn) const { m_heap.ForeachNode(fn); }
+    // Copia a 'out' del mejor al peor; reutiliza la capacidad de 'out'
+    void GetSorted(std::vector<Node> &out) const{
+        out.clear();
+        m_heap.ForeachNode([&out](const value_type &value, ref_type ref){ out.push_back(Node{value, ref}); });
+        CompareFunc cmp;
+        std::sort(out.begin(), out.end(), [&cmp](const Node &a, const Node &b){ return cmp(a.m_value, b.m_value); });
+    }
+
+    friend ostream &operator<<(ostream &os, CTopK<Traits, D> &container){
+        os << "CTopK: k = " << container.m_k << " " << container.m_heap;
+        return os;
+    }
+};
+
+// Mediana de todo el flujo con dos heaps:
+//  - m_low : heap de maximos con la mitad menor (su tope es la mediana baja)
+//  - m_high: heap de minimos con la mitad mayor
+//  - Invariante: |m_low| == |m_high| o |m_low| == |m_high| + 1
+template <typename T, size_t D = 4>
+class CRunningMedian {
+public:
+    using  value_type = T;
+private:
+    CHeap<TreeTraitDescending<T>, D> m_low;
+    CHeap<TreeTraitAscending<T>,  D> m_high;
+public:
+    // expected: cantidad de elementos esperada (reserva de una vez)
+    explicit CRunningMedian(size_t expected = 0) { reserve(expected); }
+    virtual ~CRunningMedian(){}
+
+    void Push(const value_type &val, ref_type ref = -1){
+        if( m_low.empty() || !(m_low.Top() < val) )
+            m_low.Push(val, ref);
+        else
+            m_high.Push(val, ref);
+        if( m_low.getSize() > m_high.getSize() + 1 ){
+            ref_type moved;
+            value_type top = m_low.Pop(moved);
+            m_high.Push(std::move(top), moved);
+        }
+        else if( m_high.getSize() > m_low.getSize() ){
+            ref_type moved;
+            value_type top = m_high.Pop(moved);
+            m_low.Push(std::move(top), moved);
+        }
+    }
+    // Precondicion: !empty()
+    const value_type &LowMedian()    const { return m_low.Top();    }
+    ref_type          LowMedianRef() const { return m_low.TopRef(); }
+    // Promedio de los dos centrales si la cantidad es par
+    double Median() const{
+        if( m_low.getSize() > m_high.getSize() )
+            return double(m_low.Top());
+        return (double(m_low.Top()) + double(m_high.Top())) / 2;
+    }
+
+    size_t getSize() const { return m_low.getSize() + m_high.getSize(); }
+    bool   empty()   const { return m_low.empty(); }
+    void   reserve(size_t n){
+        m_low.reserve(n / 2 + 1);
+        m_high.reserve(n / 2 + 1);
+    }
+    void   Clear(){
+        m_low.Clear();
+        m_high.Clear();
+    }
+};
+
+// Mediana de los ultimos W elementos (ventana deslizante).
+//  - Mismos dos heaps que CRunningMedian; la ref de cada entrada es su
+//    numero de secuencia, asi que "vencido" es solo ref + W < m_next.
+//  - Borrado perezoso: al vencer un elemento solo se descuenta de su lado
+//    (m_side, un anillo de W bytes); se saca fisicamente cuando llega al
+//    tope. Si los vencidos acumulados superan W se compactan ambos heaps
+//    con EraseIf: O(W) cada >= W pasos, O(1) amortizado.
+//  - Con reserve(2W + 1) por heap no se vuelve a pedir memoria.
+template <typename T, size_t D = 4>
+class CSlidingMedian {
+public:
+    using  value_type = T;
+private:
+    CHeap<TreeTraitDescending<T>, D> m_low;
+    CHeap<TreeTraitAscending<T>,  D> m_high;
+    std::vector<uint8_t> m_side;        // m_side[ref % W]: 0 = m_low, 1 = m_high
+    size_t m_window;
+    size_t m_next = 0;                  // proxima ref (secuencia)
+    size_t m_lowCount = 0, m_highCount = 0;     // vigentes en cada heap
+    size_t m_compactions = 0;
+public:
+    explicit CSlidingMedian(size_t window)
+        : m_side(window ? window : 1), m_window(window ? window : 1){
+        m_low.reserve(2 * m_window + 1);
+        m_high.reserve(2 * m_window + 1);
+    }
+    virtual ~CSlidingMedian(){}
+
+    // Devuelve la ref (secuencia) asignada al valor
+    ref_type Push(const value_type &val){
+        ref_type ref = ref_type(m_next);
+        if( m_next >= m_window )
+            Expire(m_next - m_window);
+        ++m_next;
+        Prune(m_low);                   // se compara contra un tope vigente
+        Prune(m_high);
+        if( m_lowCount == 0 || !(m_low.Top() < val) ){
+            m_low.Push(val, ref);
+            m_side[size_t(ref) % m_window] = 0;
+            ++m_lowCount;
+        }
+        else{
+            m_high.Push(val, ref);
+            m_side[size_t(ref) % m_window] = 1;
+            ++m_highCount;
+        }
+        Balance();
+        if( m_low.getSize() + m_high.getSize() > 2 * m_window )
+            Compact();
+        return ref;
+    }
+    // Precondicion: !empty()
+    const value_type &LowMedian()    const { return m_low.Top();    }
+    ref_type          LowMedianRef() const { return m_low.TopRef(); }
+    double Median() const{
+        if( m_lowCount > m_highCount )
+            return double(m_low.Top());
+        return (double(m_low.Top()) + double(m_high.Top())) / 2;
+    }
+
+    size_t getWindow()      const { return m_window;                }
+    size_t getSize()        const { return m_lowCount + m_highCount; }
+    bool   empty()          const { return getSize() == 0;          }
+    // Entradas fisicas (vigentes + vencidas aun no retiradas)
+    size_t getStored()      const { return m_low.getSize() + m_high.getSize(); }
+    size_t getCompactions() const { return m_compactions;           }
+    void   Clear(){
+        m_low.Clear();
+        m_high.Clear();
+        m_next = m_lowCount = m_highCount = 0;
+    }
+private:
+    bool Expired(ref_type ref) const { return size_t(ref) + m_window < m_next; }
+    // Se llama antes de que la ref nueva pise su lugar en m_side
+    void Expire(size_t ref){
+        if( m_side[ref % m_window] == 0 )
+            --m_lowCount;
+        else
+            --m_highCount;
+    }
+    // Deja un tope vigente (o el heap vacio)
+    template <typename Heap>
+    void Prune(Heap &heap){
+        while( !heap.empty() && Expired(heap.TopRef()) )
+            heap.Pop();
+    }
+    void Balance(){
+        while( m_lowCount > m_highCount + 1 ){
+            ref_type ref;
+            value_type top = m_low.Pop(ref);
+            m_high.Push(std::move(top), ref);
+            m_side[size_t(ref) % m_window] = 1;
+            --m_lowCount;
+            ++m_highCount;
+            Prune(m_low);
+        }
+        while( m_highCount > m_lowCount ){
+            ref_type ref;
+            value_type top = m_high.Pop(ref);
+            m_low.Push(std::move(top), ref);
+            m_side[size_t(ref) % m_window] = 0;
+            --m_highCount;
+            ++m_lowCount;
+            Prune(m_high);
+        }
+    }
+    void Compact(){
+        auto expired = [this](const value_type &, ref_type ref){ return Expired(ref); };
+        m_low.EraseIf(expired);
+        m_high.EraseIf(expired);
+        ++m_compactions;
+    }
+};
+
+#endif // __STREAMSTATS_H__
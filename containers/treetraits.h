@@ -1,14 +1,36 @@
 #include <iostream>
 #pragma once
+#include "lockpolicy.h"
+#include "nodepool.h"
 
-template <typename T>
-struct TreeTraitAscending {
+// _LockPolicy: como se protege el arbol (CRecursiveLock, CSharedLock, CNoLock)
+// _Alloc: de donde salen los nodos (CNewAllocator o CNodePool), como en ListTrait
+template <typename T, typename _CompareFunc, typename _LockPolicy = CRecursiveLock,
+          template <typename> class _Alloc = CNewAllocator>
+struct TreeTrait {
     using value_type  = T;
-    using CompareFunc = std::greater<T>;
+    using CompareFunc = _CompareFunc;
+    using LockPolicy  = _LockPolicy;
+    template <typename Node>
+    using Allocator   = _Alloc<Node>;
 };
 
-template <typename T>
-struct TreeTraitDescending {
-    using value_type  = T;
-    using CompareFunc = std::less<T>;
+template <typename T, typename _LockPolicy = CRecursiveLock>
+struct TreeTraitAscending :
+    public TreeTrait<T, std::greater<T>, _LockPolicy>{
+};
+
+template <typename T, typename _LockPolicy = CRecursiveLock>
+struct TreeTraitDescending :
+    public TreeTrait<T, std::less<T>, _LockPolicy>{
+};
+
+template <typename T, typename _LockPolicy = CRecursiveLock>
+struct TreeTraitAscendingPool :
+    public TreeTrait<T, std::greater<T>, _LockPolicy, CNodePool>{
+};
+
+template <typename T, typename _LockPolicy = CRecursiveLock>
+struct TreeTraitDescendingPool :
+    public TreeTrait<T, std::less<T>, _LockPolicy, CNodePool>{
 };
@@ -0,0 +1,293 @@
+#ifndef __UNROLLEDLIST_H__
+#define __UNROLLEDLIST_H__
+#include <iostream>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include "../general/types.h"
+#include "linkedlist.h"
+
+// Lista enlazada "desenrollada": cada nodo guarda un arreglo pequeno de
+// pares (value, ref) en vez de uno solo. El recorrido es casi secuencial
+// como en CArray y un insert en el medio solo desplaza dentro de un nodo.
+// Mantiene la misma semantica de Insert ordenado que CLinkedList.
+
+// La capacidad por nodo se calcula para que el nodo ocupe CacheLines lineas
+template <typename T, typename _Func, size_t CacheLines = 4,
+          template <typename> class _Alloc = CNodePool>
+struct UnrolledListTrait : public ListTrait<T, _Func, _Alloc>{
+    static constexpr size_t CacheLineSize = 64;
+    static constexpr size_t NodeBytes     = CacheLines * CacheLineSize;
+    static constexpr size_t HeaderBytes   = sizeof(void *) + sizeof(uint32_t);
+    static constexpr size_t NodeCapacity  =
+        (NodeBytes - HeaderBytes) / (sizeof(T) + sizeof(ref_type)) > 2 ?
+        (NodeBytes - HeaderBytes) / (sizeof(T) + sizeof(ref_type)) : 2;
+};
+
+template <typename T>
+struct AscendingUnrolledTrait  : public UnrolledListTrait<T, std::greater<T> >{};
+
+template <typename T>
+struct DescendingUnrolledTrait : public UnrolledListTrait<T, std::less<T> >{};
+
+template <typename Traits>
+struct alignas(64) NodeUnrolledList{
+    using  value_type  = typename Traits::value_type;
+    using  Node        = NodeUnrolledList<Traits>;
+    static constexpr uint32_t Capacity = Traits::NodeCapacity;
+
+    Node      *m_pNext  = nullptr;
+    uint32_t   m_nCount = 0;
+    value_type m_data[Capacity];    // valores contiguos: recorrido denso
+    ref_type   m_ref [Capacity];
+
+    bool IsFull() const { return m_nCount == Capacity; }
+    void InsertAt(uint32_t pos, const value_type &val, ref_type ref){
+        for(uint32_t i = m_nCount; i > pos; --i){
+            m_data[i] = std::move(m_data[i - 1]);
+            m_ref [i] = m_ref[i - 1];
+        }
+        m_data[pos] = val;
+        m_ref [pos] = ref;
+        ++m_nCount;
+    }
+    void EraseAt(uint32_t pos){
+        for(uint32_t i = pos + 1; i < m_nCount; ++i){
+            m_data[i - 1] = std::move(m_data[i]);
+            m_ref [i - 1] = m_ref[i];
+        }
+        --m_nCount;
+    }
+    // Pasa los elementos [from, m_nCount) al inicio de 'pOther' (vacio)
+    void MoveTail(uint32_t from, Node *pOther){
+        for(uint32_t i = from; i < m_nCount; ++i){
+            pOther->m_data[i - from] = std::move(m_data[i]);
+            pOther->m_ref [i - from] = m_ref[i];
+        }
+        pOther->m_nCount = m_nCount - from;
+        m_nCount = from;
+    }
+    // Agrega todos los de 'pOther' al final de este nodo
+    void Append(Node *pOther, uint32_t count){
+        for(uint32_t i = 0; i < count; ++i){
+            m_data[m_nCount + i] = std::move(pOther->m_data[i]);
+            m_ref [m_nCount + i] = pOther->m_ref[i];
+        }
+        m_nCount += count;
+        pOther->EraseFront(count);
+    }
+    void EraseFront(uint32_t count){
+        for(uint32_t i = count; i < m_nCount; ++i){
+            m_data[i - count] = std::move(m_data[i]);
+            m_ref [i - count] = m_ref[i];
+        }
+        m_nCount -= count;
+    }
+};
+
+template <typename Container>
+class UnrolledListForwardIterator{
+public:
+    using value_type = typename Container::value_type;
+private:
+    using Node       = typename Container::Node;
+    using Iterator   = UnrolledListForwardIterator<Container>;
+    Node    *m_pNode = nullptr;
+    uint32_t m_pos   = 0;
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = ptrdiff_t;
+    using pointer           = value_type *;
+    using reference         = value_type &;
+
+    UnrolledListForwardIterator(Node *pNode, uint32_t pos = 0)
+        : m_pNode(pNode), m_pos(pos){}
+    value_type &operator*()   { return m_pNode->m_data[m_pos]; }
+    ref_type    GetRef() const{ return m_pNode->m_ref[m_pos];  }
+    bool operator!=(const Iterator &another) const
+    { return m_pNode != another.m_pNode || m_pos != another.m_pos; }
+    bool operator==(const Iterator &another) const
+    { return !(*this != another); }
+    Iterator &operator++(){
+        if( ++m_pos == m_pNode->m_nCount ){
+            m_pNode = m_pNode->m_pNext;
+            m_pos   = 0;
+        }
+        return *this;
+    }
+};
+
+template <typename Traits>
+class CUnrolledLinkedList {
+public:
+    using  value_type  = typename Traits::value_type;
+    using  Node        = NodeUnrolledList<Traits>;
+    using  Func        = typename Traits::Func;
+    using  Allocator   = typename Traits::template Allocator<Node>;
+    using  forward_iterator  = UnrolledListForwardIterator < CUnrolledLinkedList<Traits> >;
+    static constexpr uint32_t Capacity = Node::Capacity;
+private:
+    Node  *m_pRoot = nullptr;
+    Node  *m_pLast = nullptr;
+    size_t m_nElements = 0;
+    size_t m_nNodes    = 0;
+    Allocator m_alloc;
+    Func   comp;
+public:
+    CUnrolledLinkedList(){}
+    CUnrolledLinkedList(const CUnrolledLinkedList &another);
+    CUnrolledLinkedList(CUnrolledLinkedList &&another) noexcept;
+    virtual ~CUnrolledLinkedList(){ Clear(); }
+
+    void push_back(const value_type &val, ref_type ref);
+    void Insert(const value_type &val, ref_type ref);
+    bool Remove(const value_type &val);
+    void Clear();
+    size_t getSize()  { return m_nElements;  }
+    size_t getNodes() { return m_nNodes;     }
+    size_t getBytes() { return m_nNodes * sizeof(Node); }
+
+    forward_iterator begin() { return forward_iterator(m_pRoot);  }
+    forward_iterator end()   { return forward_iterator(nullptr);  }
+private:
+    Node *NewNode(Node *pNext){
+        Node *pNode = m_alloc.New();
+        pNode->m_pNext = pNext;
+        ++m_nNodes;
+        return pNode;
+    }
+    void DeleteNode(Node *pNode){
+        m_alloc.Delete(pNode);
+        --m_nNodes;
+    }
+    // Parte un nodo lleno en dos mitades
+    void Split(Node *pNode){
+        Node *pNew = NewNode(pNode->m_pNext);
+        pNode->MoveTail(Capacity / 2, pNew);
+        pNode->m_pNext = pNew;
+        if( m_pLast == pNode )
+            m_pLast = pNew;
+    }
+
+    friend ostream &operator<<(ostream &os, CUnrolledLinkedList<Traits> &container){
+        os << "CUnrolledLinkedList: size = " << container.getSize() << endl;
+        os << "[";
+        for(auto iter = container.begin(); iter != container.end(); ++iter)
+            os << "(" << *iter << ":" << iter.GetRef() << "),";
+        os << "]" << endl;
+        return os;
+    }
+};
+
+template <typename Traits>
+CUnrolledLinkedList<Traits>::CUnrolledLinkedList(const CUnrolledLinkedList &another){
+    for(Node *pNode = another.m_pRoot; pNode; pNode = pNode->m_pNext)
+        for(uint32_t i = 0; i < pNode->m_nCount; ++i)
+            push_back(pNode->m_data[i], pNode->m_ref[i]);
+}
+
+template <typename Traits>
+CUnrolledLinkedList<Traits>::CUnrolledLinkedList(CUnrolledLinkedList &&another) noexcept
+    : m_pRoot    (std::exchange(another.m_pRoot, nullptr)),
+      m_pLast    (std::exchange(another.m_pLast, nullptr)),
+      m_nElements(std::exchange(another.m_nElements, 0)),
+      m_nNodes   (std::exchange(another.m_nNodes, 0)),
+      m_alloc    (std::move(another.m_alloc)){
+}
+
+template <typename Traits>
+void CUnrolledLinkedList<Traits>::Clear(){
+    if constexpr( CanBulkRelease<Allocator, Node>() )
+        m_alloc.Release();
+    else{
+        while( m_pRoot ){
+            Node *pNext = m_pRoot->m_pNext;
+            m_alloc.Delete(m_pRoot);
+            m_pRoot = pNext;
+        }
+    }
+    m_pRoot = m_pLast = nullptr;
+    m_nElements = m_nNodes = 0;
+}
+
+// Al final se llenan los nodos por completo (carga secuencial)
+template <typename Traits>
+void CUnrolledLinkedList<Traits>::push_back(const value_type &val, ref_type ref){
+    if( !m_pLast )
+        m_pRoot = m_pLast = NewNode(nullptr);
+    else if( m_pLast->IsFull() ){
+        m_pLast->m_pNext = NewNode(nullptr);
+        m_pLast = m_pLast->m_pNext;
+    }
+    m_pLast->InsertAt(m_pLast->m_nCount, val, ref);
+    ++m_nElements;
+}
+
+// Los iguales quedan en orden de llegada (igual que CLinkedList::Insert)
+template <typename Traits>
+void CUnrolledLinkedList<Traits>::Insert(const value_type &val, ref_type ref){
+    if( !m_pRoot ){
+        push_back(val, ref);
+        return;
+    }
+    // Nodo destino: el primero cuyo ultimo elemento va despues de 'val'
+    Node *pNode = m_pRoot;
+    if( !comp(m_pLast->m_data[m_pLast->m_nCount - 1], val) )
+        pNode = m_pLast;
+    else
+        while( pNode->m_pNext && !comp(pNode->m_data[pNode->m_nCount - 1], val) )
+            pNode = pNode->m_pNext;
+    if( pNode->IsFull() ){
+        Split(pNode);
+        if( !comp(pNode->m_data[pNode->m_nCount - 1], val) )
+            pNode = pNode->m_pNext;
+    }
+    uint32_t pos = 0;
+    while( pos < pNode->m_nCount && !comp(pNode->m_data[pos], val) )
+        ++pos;
+    pNode->InsertAt(pos, val, ref);
+    ++m_nElements;
+}
+
+// Borra la primera aparicion; si el nodo queda a menos de la mitad se
+// fusiona con el siguiente (o le pide elementos prestados)
+template <typename Traits>
+bool CUnrolledLinkedList<Traits>::Remove(const value_type &val){
+    Node *pPrev = nullptr, *pNode = m_pRoot;
+    while( pNode && comp(val, pNode->m_data[pNode->m_nCount - 1]) ){
+        pPrev = pNode;
+        pNode = pNode->m_pNext;
+    }
+    if( !pNode )
+        return false;
+    uint32_t pos = 0;
+    while( pos < pNode->m_nCount && comp(val, pNode->m_data[pos]) )
+        ++pos;
+    if( pos == pNode->m_nCount || comp(pNode->m_data[pos], val) )
+        return false;
+    pNode->EraseAt(pos);
+    --m_nElements;
+
+    if( pNode->m_nCount == 0 ){
+        (pPrev ? pPrev->m_pNext : m_pRoot) = pNode->m_pNext;
+        if( m_pLast == pNode )
+            m_pLast = pPrev;
+        DeleteNode(pNode);
+        return true;
+    }
+    Node *pNext = pNode->m_pNext;
+    if( pNode->m_nCount < Capacity / 2 && pNext ){
+        if( pNode->m_nCount + pNext->m_nCount <= Capacity ){
+            pNode->Append(pNext, pNext->m_nCount);
+            pNode->m_pNext = pNext->m_pNext;
+            if( m_pLast == pNext )
+                m_pLast = pNode;
+            DeleteNode(pNext);
+        }
+        else
+            pNode->Append(pNext, (pNext->m_nCount - pNode->m_nCount) / 2);
+    }
+    return true;
+}
+
+#endif // __UNROLLEDLIST_H__
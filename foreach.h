@@ -1,6 +1,13 @@
 #ifndef __FOREACH_H__
 #define __FOREACH_H__
 
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <utility>
+
 template <typename Iterator, typename FuncObj, typename ...Args>
 void Foreach(Iterator begin, Iterator end, FuncObj fn, Args ...args){
     auto iter = begin;
@@ -27,4 +34,282 @@ auto FirstThat(Container &container, FuncObj fn, Args ...args){
     return FirstThat(container.begin(), container.end(), fn, args...);
 }
 
-#endif
\ No newline at end of file
+// ------------------------------------------------------------------
+// Reduce, TransformReduce y Scans con politica secuencial o paralela.
+// La version paralela solo se usa con iteradores que saben saltar
+// (it + n) y medir distancias (it - it), y en los scans si ademas *out es
+// una referencia real; con cualquier otro iterador se ejecuta la secuencial.
+// 'op' debe ser asociativa e 'init' su neutro (cada hilo parte de init).
+// ------------------------------------------------------------------
+struct SequentialPolicy{};
+struct ParallelPolicy{
+    unsigned m_nThreads = 0;        // 0 = hardware_concurrency
+};
+inline const SequentialPolicy Sequential{};
+inline const ParallelPolicy   Parallel{};
+
+// El camino paralelo solo usa 'end - begin' y 'begin + k' para repartir
+// tramos: se pide eso y no la categoria completa de acceso aleatorio
+// (std::vector, punteros, CArray, ...)
+template <typename Iterator, typename = void>
+struct HasChunkArithmetic : std::false_type {};
+
+template <typename Iterator>
+struct HasChunkArithmetic<Iterator, std::void_t<
+    decltype(std::declval<const Iterator &>() - std::declval<const Iterator &>()),
+    decltype(std::declval<const Iterator &>() + std::declval<size_t>())>>
+    : std::true_type {};
+
+// Cuantos hilos vale la pena usar para n elementos
+inline unsigned ParallelWorkers(size_t n, size_t grain = 1 << 14){
+    unsigned hw = std::thread::hardware_concurrency();
+    if( !hw )
+        hw = 1;
+    size_t byGrain = n / grain;
+    if( byGrain < 1 )
+        return 1;
+    return byGrain < hw ? static_cast<unsigned>(byGrain) : hw;
+}
+
+inline unsigned ParallelWorkers(const ParallelPolicy &policy, size_t n){
+    return policy.m_nThreads ? policy.m_nThreads : ParallelWorkers(n);
+}
+
+// Ejecuta fn(i, first, last) sobre 'workers' tramos contiguos de [0, n)
+template <typename Func>
+void ParallelChunks(size_t n, unsigned workers, Func fn){
+    std::vector<std::thread> threads;
+    for(unsigned i = 1; i < workers; ++i)
+        threads.emplace_back(fn, i, n * i / workers, n * (i + 1) / workers);
+    fn(0u, size_t(0), n / workers);        // el hilo actual toma el primer tramo
+    for(auto &th : threads)
+        th.join();
+}
+
+// Parcial de un hilo, en su propia linea de cache. No se usa
+// std::vector<V>: con V = bool guarda bits y dos hilos escribirian la
+// misma palabra (carrera de datos)
+template <typename V>
+struct alignas(64) ParallelSlot{
+    V m_value;
+};
+
+// Combina los parciales por pares (arbol de log(p) niveles)
+template <typename V, typename BinaryOp>
+V TreeCombine(std::vector<ParallelSlot<V>> &partials, BinaryOp op){
+    for(size_t step = 1; step < partials.size(); step *= 2)
+        for(size_t i = 0; i + step < partials.size(); i += 2 * step)
+            partials[i].m_value = op(partials[i].m_value, partials[i + step].m_value);
+    return partials[0].m_value;
+}
+
+// Reduccion paralela de [0, n): chunk(first, last, acc) acumula su tramo
+// en 'acc' (que parte de init) y los parciales se combinan con 'op'.
+// La usan TransformReduce y CPipe::RunParallel
+template <typename V, typename BinaryOp, typename ChunkFunc>
+V ParallelReduceChunks(size_t n, unsigned workers, const V &init, BinaryOp op, ChunkFunc chunk){
+    std::vector<ParallelSlot<V>> partials(workers, ParallelSlot<V>{init});
+    ParallelChunks(n, workers, [&](unsigned i, size_t first, size_t last){
+        V acc = init;                           // parcial local
+        chunk(first, last, acc);
+        partials[i].m_value = acc;
+    });
+    return TreeCombine(partials, op);
+}
+
+// Los scans paralelos escriben tramos vecinos de 'out' desde hilos
+// distintos: solo es seguro si *out es una referencia real (no un proxy
+// como el de std::vector<bool>, que comparte palabras entre elementos)
+template <typename OutIterator>
+struct HasLvalueOutput
+    : std::is_lvalue_reference<decltype(*std::declval<OutIterator &>())> {};
+
+// ---- TransformReduce ----
+template <typename Iterator, typename V, typename BinaryOp, typename UnaryOp>
+V TransformReduce(Iterator begin, Iterator end, V init, BinaryOp op, UnaryOp transform){
+    for(auto iter = begin; iter != end; ++iter)
+        init = op(init, transform(*iter));
+    return init;
+}
+
+template <typename Iterator, typename V, typename BinaryOp, typename UnaryOp>
+V TransformReduce(const SequentialPolicy &, Iterator begin, Iterator end, V init,
+                  BinaryOp op, UnaryOp transform){
+    return TransformReduce(begin, end, init, op, transform);
+}
+
+template <typename Iterator, typename V, typename BinaryOp, typename UnaryOp>
+V TransformReduce(const ParallelPolicy &policy, Iterator begin, Iterator end, V init,
+                  BinaryOp op, UnaryOp transform){
+    if constexpr( !HasChunkArithmetic<Iterator>::value )
+        return TransformReduce(begin, end, init, op, transform);
+    else{
+        size_t n = static_cast<size_t>(end - begin);
+        unsigned workers = ParallelWorkers(policy, n);
+        if( workers <= 1 || n < workers )
+            return TransformReduce(begin, end, init, op, transform);
+        return ParallelReduceChunks(n, workers, init, op, [&](size_t first, size_t last, V &acc){
+            for(auto iter = begin + first, stop = begin + last; iter != stop; ++iter)
+                acc = op(acc, transform(*iter));
+        });
+    }
+}
+
+template <typename Container, typename V, typename BinaryOp, typename UnaryOp>
+V TransformReduce(Container &container, V init, BinaryOp op, UnaryOp transform){
+    return TransformReduce(container.begin(), container.end(), init, op, transform);
+}
+
+template <typename Policy, typename Container, typename V, typename BinaryOp, typename UnaryOp>
+V TransformReduce(const Policy &policy, Container &container, V init, BinaryOp op, UnaryOp transform){
+    return TransformReduce(policy, container.begin(), container.end(), init, op, transform);
+}
+
+// ---- Reduce ----
+struct ReduceIdentity{
+    template <typename Q>
+    Q &&operator()(Q &&elem) const { return static_cast<Q &&>(elem); }
+};
+
+template <typename Iterator, typename V, typename BinaryOp>
+V Reduce(Iterator begin, Iterator end, V init, BinaryOp op){
+    return TransformReduce(begin, end, init, op, ReduceIdentity());
+}
+
+template <typename Iterator, typename V, typename BinaryOp>
+V Reduce(const SequentialPolicy &policy, Iterator begin, Iterator end, V init, BinaryOp op){
+    return TransformReduce(policy, begin, end, init, op, ReduceIdentity());
+}
+
+template <typename Iterator, typename V, typename BinaryOp>
+V Reduce(const ParallelPolicy &policy, Iterator begin, Iterator end, V init, BinaryOp op){
+    return TransformReduce(policy, begin, end, init, op, ReduceIdentity());
+}
+
+template <typename Container, typename V, typename BinaryOp>
+V Reduce(Container &container, V init, BinaryOp op){
+    return Reduce(container.begin(), container.end(), init, op);
+}
+
+template <typename Container, typename V, typename BinaryOp>
+V Reduce(const SequentialPolicy &policy, Container &container, V init, BinaryOp op){
+    return Reduce(policy, container.begin(), container.end(), init, op);
+}
+
+template <typename Container, typename V, typename BinaryOp>
+V Reduce(const ParallelPolicy &policy, Container &container, V init, BinaryOp op){
+    return Reduce(policy, container.begin(), container.end(), init, op);
+}
+
+// ---- Scans: out[i] = op(in[0..i]) (inclusivo) / op(init, in[0..i-1]) (exclusivo) ----
+// 'out' puede ser igual a 'begin' (scan en sitio).
+template <typename Iterator, typename OutIterator, typename BinaryOp>
+OutIterator InclusiveScan(Iterator begin, Iterator end, OutIterator out, BinaryOp op){
+    if( !(begin != end) )
+        return out;
+    auto iter = begin;
+    auto acc  = *iter;
+    *out = acc;
+    for(++iter, ++out; iter != end; ++iter, ++out){
+        acc  = op(acc, *iter);
+        *out = acc;
+    }
+    return out;
+}
+
+template <typename Iterator, typename OutIterator, typename V, typename BinaryOp>
+OutIterator ExclusiveScan(Iterator begin, Iterator end, OutIterator out, V init, BinaryOp op){
+    for(auto iter = begin; iter != end; ++iter, ++out){
+        V elem = *iter;                 // leer antes de escribir (en sitio)
+        *out = init;
+        init = op(init, elem);
+    }
+    return out;
+}
+
+template <typename Iterator, typename OutIterator, typename BinaryOp>
+OutIterator InclusiveScan(const SequentialPolicy &, Iterator begin, Iterator end,
+                          OutIterator out, BinaryOp op){
+    return InclusiveScan(begin, end, out, op);
+}
+
+template <typename Iterator, typename OutIterator, typename V, typename BinaryOp>
+OutIterator ExclusiveScan(const SequentialPolicy &, Iterator begin, Iterator end,
+                          OutIterator out, V init, BinaryOp op){
+    return ExclusiveScan(begin, end, out, init, op);
+}
+
+// Scan paralelo en dos pasadas:
+//  1) cada hilo reduce su tramo           -> sums[i]
+//  2) scan secuencial de los p parciales  -> offsets[i]
+//  3) cada hilo escanea su tramo partiendo de offsets[i]
+template <typename Iterator, typename OutIterator, typename V, typename BinaryOp>
+OutIterator ExclusiveScan(const ParallelPolicy &policy, Iterator begin, Iterator end,
+                          OutIterator out, V init, BinaryOp op){
+    if constexpr( !HasChunkArithmetic<Iterator>::value ||
+                  !HasChunkArithmetic<OutIterator>::value ||
+                  !HasLvalueOutput<OutIterator>::value )
+        return ExclusiveScan(begin, end, out, init, op);
+    else{
+        size_t n = static_cast<size_t>(end - begin);
+        unsigned workers = ParallelWorkers(policy, n);
+        if( workers <= 1 || n < workers )
+            return ExclusiveScan(begin, end, out, init, op);
+        std::vector<ParallelSlot<V>> offsets(workers, ParallelSlot<V>{init});
+        ParallelChunks(n, workers, [&](unsigned i, size_t first, size_t last){
+            if( i + 1 == workers )
+                return;                         // el ultimo tramo no aporta offset
+            V acc = *(begin + first);
+            for(auto iter = begin + first + 1, stop = begin + last; iter != stop; ++iter)
+                acc = op(acc, *iter);
+            offsets[i + 1].m_value = acc;
+        });
+        offsets[0].m_value = init;
+        for(unsigned i = 1; i < workers; ++i)
+            offsets[i].m_value = op(offsets[i - 1].m_value, offsets[i].m_value);
+        ParallelChunks(n, workers, [&](unsigned i, size_t first, size_t last){
+            ExclusiveScan(begin + first, begin + last, out + first, offsets[i].m_value, op);
+        });
+        return out + n;
+    }
+}
+
+template <typename Iterator, typename OutIterator, typename BinaryOp>
+OutIterator InclusiveScan(const ParallelPolicy &policy, Iterator begin, Iterator end,
+                          OutIterator out, BinaryOp op){
+    if constexpr( !HasChunkArithmetic<Iterator>::value ||
+                  !HasChunkArithmetic<OutIterator>::value ||
+                  !HasLvalueOutput<OutIterator>::value )
+        return InclusiveScan(begin, end, out, op);
+    else{
+        using V = typename std::iterator_traits<Iterator>::value_type;
+        size_t n = static_cast<size_t>(end - begin);
+        unsigned workers = ParallelWorkers(policy, n);
+        if( workers <= 1 || n < workers )
+            return InclusiveScan(begin, end, out, op);
+        std::vector<ParallelSlot<V>> sums(workers);
+        ParallelChunks(n, workers, [&](unsigned i, size_t first, size_t last){
+            V acc = *(begin + first);
+            for(auto iter = begin + first + 1, stop = begin + last; iter != stop; ++iter)
+                acc = op(acc, *iter);
+            sums[i].m_value = acc;
+        });
+        for(unsigned i = 1; i < workers; ++i)
+            sums[i].m_value = op(sums[i - 1].m_value, sums[i].m_value);
+        ParallelChunks(n, workers, [&](unsigned i, size_t first, size_t last){
+            if( i == 0 ){
+                InclusiveScan(begin, begin + last, out, op);
+                return;
+            }
+            V acc = sums[i - 1].m_value;
+            auto dst = out + first;
+            for(auto iter = begin + first, stop = begin + last; iter != stop; ++iter, ++dst){
+                acc  = op(acc, *iter);
+                *dst = acc;
+            }
+        });
+        return out + n;
+    }
+}
+
+#endif
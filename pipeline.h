@@ -0,0 +1,263 @@
+#ifndef __PIPELINE_H__
+#define __PIPELINE_H__
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "foreach.h"
+
+// Pipeline perezoso sobre iteradores:
+//      Pipe(container) | Filter(p) | Map(f) | Take(n) | Reduce(op, init)
+// Las etapas no hacen nada hasta que llega un terminal (Reduce, Count, Apply,
+// ParallelReduce). En ese momento se componen en un unico "sink" y los datos
+// se recorren UNA sola vez, sin contenedores intermedios.
+// Cada sink retorna false cuando ya no quiere mas elementos (Take).
+
+// ---------------- Sinks ----------------
+template <typename Pred, typename Sink>
+struct FilterSink{
+    Pred m_pred;
+    Sink m_sink;
+    template <typename V>
+    bool operator()(V &&value){
+        if( m_pred(value) )
+            return m_sink(std::forward<V>(value));
+        return true;
+    }
+};
+
+template <typename Func, typename Sink>
+struct MapSink{
+    Func m_fn;
+    Sink m_sink;
+    template <typename V>
+    bool operator()(V &&value){
+        return m_sink(m_fn(std::forward<V>(value)));
+    }
+};
+
+template <typename Sink>
+struct TakeSink{
+    size_t m_remaining;
+    Sink   m_sink;
+    template <typename V>
+    bool operator()(V &&value){
+        if( !m_remaining )
+            return false;
+        --m_remaining;
+        return m_sink(std::forward<V>(value)) && m_remaining > 0;
+    }
+};
+
+template <typename Op, typename Acc>
+struct ReduceSink{
+    Op   m_op;
+    Acc *m_pAcc;
+    template <typename V>
+    bool operator()(V &&value){
+        *m_pAcc = m_op(*m_pAcc, std::forward<V>(value));
+        return true;
+    }
+};
+
+template <typename Func>
+struct ApplySink{
+    Func m_fn;
+    template <typename V>
+    bool operator()(V &&value){
+        m_fn(std::forward<V>(value));
+        return true;
+    }
+};
+
+struct CountSink{
+    size_t *m_pCount;
+    template <typename V>
+    bool operator()(V &&){
+        ++*m_pCount;
+        return true;
+    }
+};
+
+// ---------------- Etapas ----------------
+// Una etapa sabe envolver al sink siguiente (Wrap). 'parallel' indica si el
+// resultado no depende del orden en que se parten los datos.
+struct IdentityStage{
+    static constexpr bool parallel = true;
+    template <typename Sink>
+    Sink Wrap(Sink sink) const { return sink; }
+};
+
+template <typename First, typename Second>
+struct ChainStage{
+    First  m_first;
+    Second m_second;
+    static constexpr bool parallel = First::parallel && Second::parallel;
+    template <typename Sink>
+    auto Wrap(Sink sink) const { return m_first.Wrap(m_second.Wrap(sink)); }
+};
+
+template <typename Pred>
+struct FilterStage{
+    Pred m_pred;
+    static constexpr bool parallel = true;
+    template <typename Sink>
+    FilterSink<Pred, Sink> Wrap(Sink sink) const { return {m_pred, sink}; }
+};
+
+template <typename Func>
+struct MapStage{
+    Func m_fn;
+    static constexpr bool parallel = true;
+    template <typename Sink>
+    MapSink<Func, Sink> Wrap(Sink sink) const { return {m_fn, sink}; }
+};
+
+struct TakeStage{
+    size_t m_count;
+    static constexpr bool parallel = false;   // depende del orden
+    template <typename Sink>
+    TakeSink<Sink> Wrap(Sink sink) const { return {m_count, sink}; }
+};
+
+template <typename Pred>
+FilterStage<Pred> Filter(Pred pred)  { return {pred}; }
+
+template <typename Func>
+MapStage<Func>    Map(Func fn)       { return {fn};   }
+
+inline TakeStage  Take(size_t count) { return {count};  }
+
+// ---------------- Terminales ----------------
+template <typename Op, typename V>
+struct ReduceTerminal{
+    Op m_op;
+    V  m_init;
+};
+
+template <typename Op, typename V>
+struct ParallelReduceTerminal{
+    Op       m_op;
+    V        m_init;
+    unsigned m_nThreads;
+};
+
+template <typename Func>
+struct ApplyTerminal{
+    Func m_fn;
+};
+
+struct CountTerminal{};
+
+// 'init' debe ser el neutro de 'op' en ParallelReduce: cada hilo parte de el
+template <typename Op, typename V>
+ReduceTerminal<Op, V> Reduce(Op op, V init)
+{ return {op, init}; }
+
+template <typename Op, typename V>
+ParallelReduceTerminal<Op, V> ParallelReduce(Op op, V init, unsigned nThreads = 0)
+{ return {op, init, nThreads}; }
+
+template <typename Func>
+ApplyTerminal<Func> Apply(Func fn)  { return {fn}; }
+
+inline CountTerminal Count()        { return {};   }
+
+// ---------------- Pipe ----------------
+template <typename Iterator, typename Stage = IdentityStage>
+class CPipe{
+    Iterator m_begin, m_end;
+    Stage    m_stage;
+public:
+    CPipe(Iterator begin, Iterator end, Stage stage = Stage())
+        : m_begin(begin), m_end(end), m_stage(stage){}
+
+    template <typename NextStage>
+    CPipe<Iterator, ChainStage<Stage, NextStage>> Then(NextStage next){
+        return CPipe<Iterator, ChainStage<Stage, NextStage>>(m_begin, m_end, {m_stage, next});
+    }
+
+    // Un solo recorrido: todas las etapas fusionadas en 'chain'
+    template <typename Sink>
+    void Run(Sink sink){
+        RunRange(m_begin, m_end, sink);
+    }
+
+    template <typename Op, typename V>
+    V RunParallel(Op op, V init, unsigned nThreads);
+
+private:
+    template <typename Sink>
+    void RunRange(Iterator begin, Iterator end, Sink sink){
+        auto chain = m_stage.Wrap(sink);
+        for(auto iter = begin; iter != end; ++iter)
+            if( !chain(*iter) )
+                break;
+    }
+};
+
+template <typename Iterator, typename Stage>
+template <typename Op, typename V>
+V CPipe<Iterator, Stage>::RunParallel(Op op, V init, unsigned nThreads){
+    static_assert(HasChunkArithmetic<Iterator>::value,
+                  "ParallelReduce requiere iteradores con it + n e it - it");
+    static_assert(Stage::parallel,
+                  "ParallelReduce no admite etapas que dependen del orden (Take)");
+    size_t n = static_cast<size_t>(m_end - m_begin);
+    unsigned workers = nThreads ? nThreads : ParallelWorkers(n);
+    if( workers <= 1 || n < workers ){
+        V acc = init;
+        RunRange(m_begin, m_end, ReduceSink<Op, V>{op, &acc});
+        return acc;
+    }
+    return ParallelReduceChunks(n, workers, init, op, [&](size_t first, size_t last, V &acc){
+        RunRange(m_begin + first, m_begin + last, ReduceSink<Op, V>{op, &acc});
+    });
+}
+
+template <typename Container>
+auto Pipe(Container &container){
+    return CPipe<decltype(container.begin())>(container.begin(), container.end());
+}
+
+template <typename Iterator>
+CPipe<Iterator> Pipe(Iterator begin, Iterator end){
+    return CPipe<Iterator>(begin, end);
+}
+
+// Composicion de etapas
+template <typename Iterator, typename Stage, typename Pred>
+auto operator|(CPipe<Iterator, Stage> pipe, FilterStage<Pred> next){ return pipe.Then(next); }
+
+template <typename Iterator, typename Stage, typename Func>
+auto operator|(CPipe<Iterator, Stage> pipe, MapStage<Func> next)   { return pipe.Then(next); }
+
+template <typename Iterator, typename Stage>
+auto operator|(CPipe<Iterator, Stage> pipe, TakeStage next)        { return pipe.Then(next); }
+
+// Terminales
+template <typename Iterator, typename Stage, typename Op, typename V>
+V operator|(CPipe<Iterator, Stage> pipe, ReduceTerminal<Op, V> terminal){
+    V acc = terminal.m_init;
+    pipe.Run(ReduceSink<Op, V>{terminal.m_op, &acc});
+    return acc;
+}
+
+template <typename Iterator, typename Stage, typename Op, typename V>
+V operator|(CPipe<Iterator, Stage> pipe, ParallelReduceTerminal<Op, V> terminal){
+    return pipe.RunParallel(terminal.m_op, terminal.m_init, terminal.m_nThreads);
+}
+
+template <typename Iterator, typename Stage, typename Func>
+void operator|(CPipe<Iterator, Stage> pipe, ApplyTerminal<Func> terminal){
+    pipe.Run(ApplySink<Func>{terminal.m_fn});
+}
+
+template <typename Iterator, typename Stage>
+size_t operator|(CPipe<Iterator, Stage> pipe, CountTerminal){
+    size_t count = 0;
+    pipe.Run(CountSink{&count});
+    return count;
+}
+
+#endif // __PIPELINE_H__
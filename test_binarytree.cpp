@@ -7,8 +7,10 @@
 //    3) Forward Iterator (begin/end) y Backward Iterator (rbegin/rend)
 //    4) Recorridos PreOrder, InOrder y PostOrder (cualquier nombre)
 //    5) Foreach y FirstThat con variadic templates
-//    6) operator<< y operator>>
-//    7) Mutex (prueba de concurrencia)
+//    6) operator<< y operator>> (y BuildFromSorted: carga balanceada en O(n))
+//    7) Mutex (prueba de concurrencia) y throughput con mezcla
+//       lectura/escritura para cada LockPolicy (recursive/shared/sin lock)
+//    8) Asignador de nodos por Traits (CNodePool): copia, move y Clear
 // ============================================================
 
 #include <iostream>
@@ -19,6 +21,10 @@
 #include <type_traits>
 #include <algorithm>
 #include <functional>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <string>
 
 // --- INCLUSION OBLIGATORIA ---
 #include "containers/binarytree.h"
@@ -126,6 +132,7 @@ MAKE_TRAVERSAL_DETECTOR(has_inorder,         inorder);
 MAKE_TRAVERSAL_DETECTOR(has_in_order,        in_order);
 MAKE_TRAVERSAL_DETECTOR(has_traverseInOrder, traverseInOrder);
 MAKE_TRAVERSAL_DETECTOR(has_TraversalIn,     TraversalIn);
+MAKE_TRAVERSAL_DETECTOR(has_Inorden,         Inorden);
 
 // PreOrder y variantes
 MAKE_TRAVERSAL_DETECTOR(has_PreOrder,         PreOrder);
@@ -134,6 +141,7 @@ MAKE_TRAVERSAL_DETECTOR(has_preorder,         preorder);
 MAKE_TRAVERSAL_DETECTOR(has_pre_order,        pre_order);
 MAKE_TRAVERSAL_DETECTOR(has_traversePreOrder, traversePreOrder);
 MAKE_TRAVERSAL_DETECTOR(has_TraversalPre,     TraversalPre);
+MAKE_TRAVERSAL_DETECTOR(has_Preorden,         Preorden);
 
 // PostOrder y variantes
 MAKE_TRAVERSAL_DETECTOR(has_PostOrder,         PostOrder);
@@ -142,6 +150,7 @@ MAKE_TRAVERSAL_DETECTOR(has_postorder,         postorder);
 MAKE_TRAVERSAL_DETECTOR(has_post_order,        post_order);
 MAKE_TRAVERSAL_DETECTOR(has_traversePostOrder, traversePostOrder);
 MAKE_TRAVERSAL_DETECTOR(has_TraversalPost,     TraversalPost);
+MAKE_TRAVERSAL_DETECTOR(has_Postorden,         Postorden);
 
 // Foreach y variantes
 MAKE_TRAVERSAL_DETECTOR(has_Foreach,  Foreach);
@@ -197,6 +206,7 @@ bool call_inorder(Tree& t, std::function<void(int&)> fn) {
     else if constexpr (has_in_order<Tree>::value)   { t.in_order(fn);        return true; }
     else if constexpr (has_traverseInOrder<Tree>::value) { t.traverseInOrder(fn); return true; }
     else if constexpr (has_TraversalIn<Tree>::value)     { t.TraversalIn(fn);     return true; }
+    else if constexpr (has_Inorden<Tree>::value)         { t.Inorden(fn);         return true; }
     return false;
 }
 
@@ -208,6 +218,7 @@ bool call_preorder(Tree& t, std::function<void(int&)> fn) {
     else if constexpr (has_pre_order<Tree>::value)   { t.pre_order(fn);           return true; }
     else if constexpr (has_traversePreOrder<Tree>::value) { t.traversePreOrder(fn); return true; }
     else if constexpr (has_TraversalPre<Tree>::value)     { t.TraversalPre(fn);     return true; }
+    else if constexpr (has_Preorden<Tree>::value)         { t.Preorden(fn);         return true; }
     return false;
 }
 
@@ -219,6 +230,7 @@ bool call_postorder(Tree& t, std::function<void(int&)> fn) {
     else if constexpr (has_post_order<Tree>::value)   { t.post_order(fn);            return true; }
     else if constexpr (has_traversePostOrder<Tree>::value) { t.traversePostOrder(fn); return true; }
     else if constexpr (has_TraversalPost<Tree>::value)     { t.TraversalPost(fn);     return true; }
+    else if constexpr (has_Postorden<Tree>::value)         { t.Postorden(fn);         return true; }
     return false;
 }
 
@@ -582,6 +594,42 @@ void TestStreamOperators() {
     for (auto it = t2.begin(); it != t2.end(); ++it) rv.push_back(*it);
     assert(ov == rv && "operator>>: el arbol restaurado debe ser identico al original");
     pass("operator>>: deserializa y reconstruye el arbol correctamente");
+
+    // BuildFromSorted: 1..7 debe quedar perfectamente balanceado
+    std::vector<int> sorted = {1, 2, 3, 4, 5, 6, 7}, pre;
+    TreeType b;
+    b.Insert(100, 0);                                       // se reemplaza
+    b.BuildFromSorted(sorted.begin(), sorted.end());
+    call_preorder(b, [&pre](int& v){ pre.push_back(v); });
+    assert((pre == std::vector<int>{4, 2, 1, 3, 6, 5, 7}) && "BuildFromSorted: debe quedar balanceado");
+    std::vector<int> back;
+    for (auto it = b.rbegin(); it != b.rend(); ++it) back.push_back(*it);
+    assert((back == std::vector<int>{7, 6, 5, 4, 3, 2, 1}) && "BuildFromSorted: m_pParent correctos");
+    pass("BuildFromSorted: arbol balanceado con punteros al padre correctos");
+
+    // Entrada desordenada (con refs): se ordena y se arma igual
+    std::vector<std::pair<int, ref_type>> unsorted = {{5,0},{3,1},{9,2},{1,3},{7,4},{2,5},{8,6},{6,7},{4,8}};
+    b.BuildFromSorted(unsorted.begin(), unsorted.end());
+    pre.clear();
+    call_preorder(b, [&pre](int& v){ pre.push_back(v); });
+    std::vector<int> in;
+    for (auto it = b.begin(); it != b.end(); ++it) in.push_back(*it);
+    assert(pre.front() == 5 && in == (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9}) &&
+        "BuildFromSorted: entrada desordenada debe ordenarse y quedar balanceada");
+    pass("BuildFromSorted: detecta entrada desordenada y la ordena");
+
+    // Snapshot de operator<< (ordenado) recargado: raiz = mediana
+    TreeType big;
+    for (int i = 0; i < 10000; ++i) big.Insert((i * 7919) % 10000, i);
+    std::ostringstream snap;
+    snap << big;
+    TreeType reloaded;
+    std::istringstream snapIn(snap.str());
+    snapIn >> reloaded;
+    pre.clear();
+    call_preorder(reloaded, [&pre](int& v){ pre.push_back(v); });
+    assert(pre.size() == 10000 && pre.front() == 4999 && "operator>>: snapshot ordenado debe armarse balanceado");
+    pass("operator>>: snapshot ordenado se recarga balanceado");
 }
 
 // ============================================================
@@ -608,6 +656,126 @@ void TestConcurrency() {
     pass("Mutex: todos los nodos insertados concurrentemente estan presentes");
 }
 
+// ============================================================
+//  TEST 7b – Mezcla lectura/escritura por LockPolicy (throughput)
+//  Cada hilo hace OPS operaciones: readPct% lecturas (Find, Contains,
+//  LowerBound y un ForeachInRange corto) y el resto Insert de claves
+//  nuevas. Al final deben estar todas las claves insertadas.
+// ============================================================
+template <typename Tree>
+double ReadWriteMix(int nThreads, int readPct, int ops) {
+    const int BASE = 20000;
+    Tree t;
+    std::mt19937 gen(1);
+    for (int i = 0; i < BASE; ++i) {
+        int key = int(gen() % (1 << 29)) * 2;        // pares: las del test son impares
+        t.Insert(key, key);
+    }
+    std::vector<int> inserted(nThreads, 0);
+    auto job = [&t, &inserted, readPct, ops](int id) {
+        std::mt19937 local(100 + id);
+        long long sink = 0;
+        for (int i = 0; i < ops; ++i) {
+            int key = int(local() % (1 << 29)) * 2;
+            if (int(local() % 100) < readPct) {
+                sink += t.Find(key) != nullptr;
+                sink += t.Contains(key + 2);
+                auto it = t.LowerBound(key);
+                if (it != t.end()) sink += *it;
+                t.ForeachInRange(key, key + 1000000, [&sink](int& v){ sink += v; });
+            } else {
+                // impar y unica: multiplicar por un impar es biyectivo mod 2^29
+                unsigned seq = unsigned(id * ops + i);
+                int k = int((seq * 2654435761u) % (1u << 29)) * 2 + 1;
+                t.Insert(k, k);
+                ++inserted[id];
+            }
+        }
+        if (sink == 42) std::cout << "";                     // evita que se optimice
+    };
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nThreads; ++i)
+        threads.emplace_back(job, i);
+    for (auto& th : threads) th.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    int total = BASE;
+    for (int n : inserted) total += n;
+    int nodes = 0, odd = 0;
+    t.Foreach([&nodes, &odd](int& v){ ++nodes; odd += v % 2 != 0; });
+    assert(nodes == total && odd == total - BASE &&
+        "LockPolicy: se perdieron inserciones en la mezcla lectura/escritura");
+    return double(nThreads) * ops / secs / 1e6;
+}
+
+void TestReadWriteMix() {
+    sect("REQUERIMIENTO 7b: LockPolicy y mezcla lectura/escritura (Mops)");
+    using RecursiveTree = CBinaryTree< TreeTraitAscending<int, CRecursiveLock> >;
+    using SharedTree    = CBinaryTree< TreeTraitAscending<int, CSharedLock> >;
+    using NoLockTree    = CBinaryTree< TreeTraitAscending<int, CNoLock> >;
+    const int THREADS = 8, OPS = 20000;
+
+    std::cout << "  " << std::setw(10) << "lecturas" << std::setw(14) << "recursive"
+              << std::setw(14) << "shared" << "\n";
+    for (int readPct : {100, 90, 50}) {
+        double rec = ReadWriteMix<RecursiveTree>(THREADS, readPct, OPS);
+        double sh  = ReadWriteMix<SharedTree>   (THREADS, readPct, OPS);
+        std::cout << "  " << std::setw(9) << readPct << "%" << std::fixed << std::setprecision(2)
+                  << std::setw(14) << rec << std::setw(14) << sh << "\n";
+    }
+    pass("CRecursiveLock y CSharedLock: ninguna insercion perdida con 8 hilos");
+
+    double single = ReadWriteMix<NoLockTree>(1, 90, OPS * THREADS);
+    std::cout << "  CNoLock (1 hilo, 90% lecturas): " << single << " Mops\n";
+    pass("CNoLock: correcto desde un solo hilo");
+}
+
+// ============================================================
+//  TEST 8 – Asignador de nodos por Traits (CNodePool)
+//  Los nodos removidos se reciclan; el move se lleva el pool (los nodos
+//  siguen validos al destruir el origen); Clear libera en bloque.
+// ============================================================
+template <typename Tree, typename MakeValue>
+std::vector<typename Tree::value_type> PoolRoundTrip(MakeValue make) {
+    Tree t;
+    for (int i = 0; i < 1000; ++i) t.Insert(make((i * 7919) % 1000), i);
+    for (int i = 0; i < 1000; i += 2) t.Remove(make(i));
+    for (int i = 0; i < 1000; i += 4) t.Insert(make(i), i);          // reusa la free list
+    Tree copy(t);
+    Tree moved;
+    {
+        Tree src(std::move(copy));
+        moved = std::move(src);
+    }                                                                 // src y copy ya no tienen nodos
+    Tree assigned;
+    assigned.Insert(make(5000), 0);
+    assigned = moved;
+    std::vector<typename Tree::value_type> out;
+    assigned.Foreach([&out](typename Tree::value_type& v){ out.push_back(v); });
+    moved.Clear();
+    assert(!(moved.begin() != moved.end()) && "Clear: el arbol debe quedar vacio");
+    moved.Insert(make(1), 1);
+    assert(moved.Contains(make(1)) && "Clear: el arbol debe seguir usable");
+    return out;
+}
+
+void TestNodeAllocator() {
+    sect("REQUERIMIENTO 8: Asignador de nodos por Traits (CNodePool)");
+    auto asInt = [](int i){ return i; };
+    auto pooled = PoolRoundTrip< CBinaryTree< TreeTraitAscendingPool<int> > >(asInt);
+    auto plain  = PoolRoundTrip< CBinaryTree< TreeTraitAscending<int> > >(asInt);
+    assert(pooled == plain && pooled.size() == 750 &&
+        "CNodePool: mismo contenido que con new/delete");
+    assert(std::is_sorted(pooled.begin(), pooled.end()) && "CNodePool: in-orden ordenado");
+    pass("CNodePool: Insert/Remove/copia/move/Clear igual que new/delete");
+
+    auto asString = [](int i){ return std::to_string(i); };
+    auto strings = PoolRoundTrip< CBinaryTree< TreeTraitAscendingPool<std::string> > >(asString);
+    assert(strings.size() == 750 && "CNodePool: valores no triviales se destruyen uno a uno");
+    pass("CNodePool: valores no triviales (std::string)");
+}
+
 // ============================================================
 //  MAIN
 // ============================================================
@@ -624,6 +792,8 @@ int main() {
     TestVariadicTemplates();
     TestStreamOperators();
     TestConcurrency();
+    TestReadWriteMix();
+    TestNodeAllocator();
 
     std::cout << "\n=======================================================\n";
     std::cout << "  TODAS LAS PRUEBAS PASARON EXITOSAMENTE\n";